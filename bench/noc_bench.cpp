@@ -0,0 +1,500 @@
+#include <systemc.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "noc.h"
+#include "router.h"
+#include "routing_algorithms.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#define bench_popen _popen
+#define bench_pclose _pclose
+#else
+#include <sys/resource.h>
+#define bench_popen popen
+#define bench_pclose pclose
+#endif
+
+// Suite de microbenchmarks do simulador NoC
+//
+// Componentes puros (Packet, FIFO, algoritmos de roteamento) são medidos no
+// próprio processo. Cenários SystemC (um Router isolado, malha completa) rodam
+// cada um em um processo filho, pois o SystemC só permite uma elaboração por
+// processo; o filho imprime uma linha JSON que o processo pai coleta.
+
+namespace {
+
+// Destino dos resultados para impedir que o compilador elimine os laços
+volatile long long g_sink = 0;
+
+typedef std::chrono::steady_clock BenchClock;
+
+double elapsed_seconds(BenchClock::time_point start) {
+    return std::chrono::duration<double>(BenchClock::now() - start).count();
+}
+
+// Pico de memória residente do processo atual em KB
+long peak_rss_kb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // macOS reporta em bytes
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Buffer que descarta tudo o que recebe, sem guardar nem alocar: o log por
+// pacote não entra no tempo medido nem no pico de memória
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Resultado de um benchmark: nome, métrica principal (menor é melhor) e campos extras
+struct BenchResult {
+    std::string name;
+    std::string metric;
+    double value;
+    std::vector<std::pair<std::string, double>> extra;
+
+    std::string toJson() const {
+        std::ostringstream os;
+        os << "{\"name\": \"" << name << "\", \"metric\": \"" << metric << "\", \""
+           << metric << "\": " << value;
+        for (const auto& field : extra) {
+            os << ", \"" << field.first << "\": " << field.second;
+        }
+        os << "}";
+        return os.str();
+    }
+};
+
+// Extrair um campo textual de uma linha JSON gerada por BenchResult::toJson
+std::string json_string_field(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\": \"";
+    size_t pos = line.find(pattern);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += pattern.size();
+    size_t end = line.find('"', pos);
+    return end == std::string::npos ? "" : line.substr(pos, end - pos);
+}
+
+// Extrair um campo numérico de uma linha JSON gerada por BenchResult::toJson
+bool json_number_field(const std::string& line, const std::string& key, double& value) {
+    std::string pattern = "\"" + key + "\": ";
+    size_t pos = line.find(pattern);
+    if (pos == std::string::npos) {
+        return false;
+    }
+    value = std::atof(line.c_str() + pos + pattern.size());
+    return true;
+}
+
+// Repetições por benchmark; o melhor tempo é reportado para reduzir ruído
+int g_repeat = 3;
+
+// Executar um laço de microbenchmark e reportar ns por operação
+template <typename Body>
+BenchResult run_micro(const std::string& name, long iterations, Body body) {
+    // Aquecimento para popular caches e o alocador
+    for (long i = 0; i < iterations / 10; i++) {
+        body(i);
+    }
+
+    double seconds = 0;
+    for (int r = 0; r < g_repeat; r++) {
+        BenchClock::time_point start = BenchClock::now();
+        for (long i = 0; i < iterations; i++) {
+            body(i);
+        }
+        double run_seconds = elapsed_seconds(start);
+        if (r == 0 || run_seconds < seconds) {
+            seconds = run_seconds;
+        }
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.metric = "ns_per_op";
+    result.value = seconds * 1e9 / iterations;
+    result.extra.push_back(std::make_pair("iterations", static_cast<double>(iterations)));
+    result.extra.push_back(std::make_pair("ops_per_sec", iterations / seconds));
+    return result;
+}
+
+// Pacote representativo de meio de percurso (caminho já maior que o SSO de std::string)
+Packet make_sample_packet() {
+    Packet packet(3, 12, Packet::DATA, 42, 100);
+    for (int hop : {3, 2, 1, 0, 4, 8, 12}) {
+        packet.addToPath(hop);
+        packet.incrementHops();
+    }
+    return packet;
+}
+
+void run_micro_benchmarks(std::vector<BenchResult>& results, long scale) {
+    const Packet sample = make_sample_packet();
+
+    results.push_back(run_micro("packet_copy", 2000000 * scale, [&](long i) {
+        Packet copy(sample);
+        g_sink = g_sink + copy.getHops() + i;
+    }));
+
+    // FIFO de entrada do router: encher até BUFFER_SIZE e esvaziar
+    std::queue<Packet> fifo;
+    results.push_back(run_micro("input_fifo_push_pop", 500000 * scale, [&](long) {
+        for (int k = 0; k < Router::BUFFER_SIZE; k++) {
+            fifo.push(sample);
+        }
+        while (!fifo.empty()) {
+            g_sink = g_sink + fifo.front().getDstId();
+            fifo.pop();
+        }
+    }));
+
+    // calculateOutputPort para todos os pares (origem, destino) de uma malha 8x8
+    const int mesh = 8;
+    const int nodes = mesh * mesh;
+    for (const char* algorithm : {"XY", "WEST_FIRST"}) {
+        std::unique_ptr<RoutingAlgorithm> routing(createRoutingAlgorithm(algorithm));
+        results.push_back(run_micro(std::string("route_") + algorithm, 5000000 * scale, [&](long i) {
+            int src = static_cast<int>(i % nodes);
+            int dst = static_cast<int>((i / nodes) % nodes);
+            g_sink = g_sink + routing->calculateOutputPort(
+                src % mesh, src / mesh, dst % mesh, dst / mesh);
+        }));
+    }
+}
+
+// Bancada para um Router isolado no centro de uma malha 3x3, com todas as
+// entradas saturadas e todas as saídas sempre prontas
+class RouterBenchHarness : public sc_module {
+public:
+    sc_clock clk;
+    Router router;
+
+    sc_signal<Packet> in_packet_sigs[5];
+    sc_signal<bool> in_valid_sigs[5];
+    sc_signal<int> in_ready_sigs[5];
+    sc_signal<Packet> out_packet_sigs[5];
+    sc_signal<bool> out_valid_sigs[5];
+    sc_signal<int> out_ready_sigs[5];
+
+    RouterBenchHarness(sc_module_name name) :
+        sc_module(name),
+        clk("bench_clk", sc_time(1, SC_NS)),
+        router("bench_router", 1, 1, 3, 3, createRoutingAlgorithm("XY")),
+        forwarded_(0),
+        seed_(12345) {
+
+        router.clk(clk);
+        for (int i = 0; i < 5; i++) {
+            router.in_packets[i](in_packet_sigs[i]);
+            router.in_valids[i](in_valid_sigs[i]);
+            router.in_readys[i](in_ready_sigs[i]);
+            router.out_packets[i](out_packet_sigs[i]);
+            router.out_valids[i](out_valid_sigs[i]);
+            router.out_readys[i](out_ready_sigs[i]);
+        }
+
+        SC_METHOD(drive);
+        sensitive << clk.posedge_event();
+    }
+
+    long getForwarded() const { return forwarded_; }
+
+private:
+    long forwarded_;
+    unsigned seed_;
+
+    void drive() {
+        for (int i = 0; i < 5; i++) {
+            out_ready_sigs[i].write(Packet::ALL_CLASSES_MASK);
+            if (out_valid_sigs[i].read()) {
+                forwarded_++;
+            }
+
+            // Gerador congruencial simples: barato e determinístico
+            seed_ = seed_ * 1103515245u + 12345u;
+            int dest = static_cast<int>((seed_ >> 16) % 9);
+            in_packet_sigs[i].write(Packet(4, dest, Packet::DATA, i, 0));
+            in_valid_sigs[i].write(true);
+        }
+    }
+};
+
+// Processo filho: um único Router por N ciclos
+BenchResult run_router_child(int cycles) {
+    RouterBenchHarness harness("router_bench");
+
+    BenchClock::time_point start = BenchClock::now();
+    sc_start(sc_time(cycles, SC_NS));
+    double seconds = elapsed_seconds(start);
+
+    BenchResult result;
+    result.name = "router_cycle";
+    result.metric = "ns_per_router_cycle";
+    result.value = seconds * 1e9 / cycles;
+    result.extra.push_back(std::make_pair("cycles", static_cast<double>(cycles)));
+    result.extra.push_back(std::make_pair("sim_cycles_per_sec", cycles / seconds));
+    result.extra.push_back(std::make_pair("packets_per_sec", harness.getForwarded() / seconds));
+    result.extra.push_back(std::make_pair("peak_rss_kb", static_cast<double>(peak_rss_kb())));
+    return result;
+}
+
+// Processo filho: malha completa NxN com a taxa de injeção informada
+BenchResult run_mesh_child(int size, int rate, int cycles, const std::string& routing) {
+    // Silenciar o log por pacote durante a medição; o JSON é impresso depois
+    NullBuffer discard;
+    std::streambuf* original = std::cout.rdbuf(&discard);
+
+    NoC noc("bench_noc", size, size, routing, rate, cycles);
+
+    BenchClock::time_point start = BenchClock::now();
+    sc_start(noc.getRunDuration());
+    double seconds = elapsed_seconds(start);
+
+    std::cout.rdbuf(original);
+
+    // run_simulation drena a rede por 100 ciclos extras após o fim da injeção
+    double simulated_cycles = cycles + 100;
+    double router_cycles = simulated_cycles * noc.getNumRouters();
+
+    BenchResult result;
+    result.name = "mesh_" + std::to_string(size) + "x" + std::to_string(size) +
+                  "_" + routing + "_rate" + std::to_string(rate);
+    result.metric = "ns_per_router_cycle";
+    result.value = seconds * 1e9 / router_cycles;
+    result.extra.push_back(std::make_pair("cycles", simulated_cycles));
+    result.extra.push_back(std::make_pair("sim_cycles_per_sec", simulated_cycles / seconds));
+    result.extra.push_back(std::make_pair("packets_per_sec", noc.getTotalPacketsReceived() / seconds));
+    result.extra.push_back(std::make_pair("peak_rss_kb", static_cast<double>(peak_rss_kb())));
+    return result;
+}
+
+// Executar um cenário SystemC em um processo filho e coletar sua linha JSON
+bool run_child(const std::string& self, const std::string& args, BenchResult& result) {
+    std::string command = "\"" + self + "\" " + args;
+    FILE* pipe = bench_popen(command.c_str(), "r");
+    if (!pipe) {
+        return false;
+    }
+
+    std::string line;
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), pipe)) {
+        std::string chunk(buffer);
+        if (chunk.find("\"metric\"") != std::string::npos) {
+            line = chunk;
+        }
+    }
+    bench_pclose(pipe);
+
+    if (line.empty()) {
+        return false;
+    }
+
+    result.name = json_string_field(line, "name");
+    result.metric = json_string_field(line, "metric");
+    json_number_field(line, result.metric, result.value);
+    for (const char* key : {"cycles", "sim_cycles_per_sec", "packets_per_sec", "peak_rss_kb"}) {
+        double value;
+        if (json_number_field(line, key, value)) {
+            result.extra.push_back(std::make_pair(key, value));
+        }
+    }
+    return true;
+}
+
+std::string results_to_json(const std::vector<BenchResult>& results) {
+    std::ostringstream os;
+    os << "{\n  \"suite\": \"noc_bench\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        os << "    " << results[i].toJson() << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+    return os.str();
+}
+
+// Comparar com um baseline armazenado; retorna o número de regressões
+int compare_with_baseline(const std::vector<BenchResult>& results,
+                          const std::string& baseline_file, double tolerance_pct) {
+    std::ifstream in(baseline_file);
+    if (!in) {
+        std::cerr << "Erro: não foi possível abrir o baseline " << baseline_file << std::endl;
+        return -1;
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string name = json_string_field(line, "name");
+        std::string metric = json_string_field(line, "metric");
+        double value;
+        if (!name.empty() && json_number_field(line, metric, value)) {
+            baseline[name] = value;
+        }
+    }
+
+    int regressions = 0;
+    std::cerr << "\n-------- Benchmark Comparison (tolerance " << tolerance_pct << "%) --------" << std::endl;
+    for (const auto& result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0) {
+            std::cerr << result.name << ": NEW (no baseline)" << std::endl;
+            continue;
+        }
+
+        double change_pct = (result.value - it->second) / it->second * 100.0;
+        bool regressed = change_pct > tolerance_pct;
+        if (regressed) {
+            regressions++;
+        }
+
+        std::cerr << result.name << ": " << it->second << " -> " << result.value
+                  << " " << result.metric << " (" << (change_pct >= 0 ? "+" : "") << change_pct << "%)"
+                  << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+    std::cerr << "Regressions: " << regressions << std::endl;
+    return regressions;
+}
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  -quick            Reduz iterações e ciclos (execução rápida)" << std::endl;
+    std::cout << "  -out ARQUIVO      Grava o relatório JSON também em ARQUIVO" << std::endl;
+    std::cout << "  -baseline ARQUIVO Compara com um relatório anterior e sinaliza regressões" << std::endl;
+    std::cout << "  -tolerance PCT    Piora máxima aceita antes de sinalizar regressão (padrão: 10)" << std::endl;
+    std::cout << "  -repeat N         Repetições por benchmark, reporta a melhor (padrão: 3)" << std::endl;
+    std::cout << "  -help, -h         Mostra esta mensagem de ajuda" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    std::string out_file;
+    std::string baseline_file;
+    double tolerance_pct = 10.0;
+
+    // Parâmetros do modo filho (uso interno)
+    std::string child_mode;
+    int size = 4;
+    int rate = 10;
+    int cycles = 1000;
+    std::string routing = "XY";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "-quick") {
+            quick = true;
+        } else if (arg == "-out" && i + 1 < argc) {
+            out_file = argv[++i];
+        } else if (arg == "-baseline" && i + 1 < argc) {
+            baseline_file = argv[++i];
+        } else if (arg == "-tolerance" && i + 1 < argc) {
+            tolerance_pct = std::atof(argv[++i]);
+        } else if (arg == "-repeat" && i + 1 < argc) {
+            g_repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-run" && i + 1 < argc) {
+            child_mode = argv[++i];
+        } else if (arg == "-size" && i + 1 < argc) {
+            size = std::atoi(argv[++i]);
+        } else if (arg == "-rate" && i + 1 < argc) {
+            rate = std::atoi(argv[++i]);
+        } else if (arg == "-cycles" && i + 1 < argc) {
+            cycles = std::atoi(argv[++i]);
+        } else if (arg == "-routing" && i + 1 < argc) {
+            routing = argv[++i];
+        } else if (arg == "-help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+    }
+
+    if (child_mode == "router") {
+        std::cout << run_router_child(cycles).toJson() << std::endl;
+        return 0;
+    } else if (child_mode == "mesh") {
+        std::cout << run_mesh_child(size, rate, cycles, routing).toJson() << std::endl;
+        return 0;
+    }
+
+    std::vector<BenchResult> results;
+    long scale = quick ? 1 : 5;
+    int sim_cycles = quick ? 500 : 2000;
+
+    std::cerr << "Executando microbenchmarks de componentes..." << std::endl;
+    run_micro_benchmarks(results, scale);
+
+    // Cenários SystemC: um router isolado e malhas de vários tamanhos e cargas
+    std::vector<std::string> child_args;
+    child_args.push_back("-run router -cycles " + std::to_string(sim_cycles * 20));
+    for (int mesh_size : {4, 8, 16}) {
+        for (int mesh_rate : {5, 30}) {
+            child_args.push_back("-run mesh -size " + std::to_string(mesh_size) +
+                                 " -rate " + std::to_string(mesh_rate) +
+                                 " -cycles " + std::to_string(sim_cycles) + " -routing XY");
+        }
+    }
+
+    for (const auto& args : child_args) {
+        std::cerr << "Executando cenário: " << args << std::endl;
+        BenchResult best;
+        bool ok = false;
+        for (int r = 0; r < g_repeat; r++) {
+            BenchResult result;
+            if (run_child(argv[0], args, result) && (!ok || result.value < best.value)) {
+                best = result;
+                ok = true;
+            }
+        }
+
+        if (ok) {
+            results.push_back(best);
+        } else {
+            std::cerr << "Erro: cenário falhou: " << args << std::endl;
+        }
+    }
+
+    std::string report = results_to_json(results);
+    std::cout << report;
+    if (!out_file.empty()) {
+        std::ofstream out(out_file);
+        out << report;
+    }
+
+    if (!baseline_file.empty()) {
+        int regressions = compare_with_baseline(results, baseline_file, tolerance_pct);
+        if (regressions != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
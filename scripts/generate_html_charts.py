@@ -6,12 +6,38 @@ Cria gráficos em HTML para visualização em navegador
 
 import os
 import re
+import csv
 import glob
 import json
 from datetime import datetime
 
+# CSV gerado por bin/results_aggregator a partir de test_outputs/results.nocr
+AGGREGATES_FILE = os.path.join("test_outputs", "results_aggregates.csv")
+
+def parse_aggregates():
+    """Ler as médias entre sementes de cada configuração do CSV agregado"""
+    results = []
+    with open(AGGREGATES_FILE, 'r', encoding='utf-8', newline='') as f:
+        for row in csv.DictReader(f):
+            results.append({
+                'algorithm': row['routing'],
+                'mesh_size': int(row['size']),
+                'injection_rate': int(row['rate']),
+                'total_sent': float(row['sent_mean']),
+                'total_received': float(row['received_mean']),
+                'avg_latency': float(row['avg_latency_mean']),
+                'avg_hops': float(row['avg_hops_mean']),
+                'throughput': float(row['delivery_mean']),
+                'timestamp': ''
+            })
+    return results
+
 def parse_test_results():
     """Analisar todos os arquivos de teste"""
+    # Resultados já agregados pelo results_aggregator: sem reler os logs
+    if os.path.exists(AGGREGATES_FILE):
+        return parse_aggregates()
+    
     pattern = os.path.join("test_outputs", "test_*.txt")
     files = glob.glob(pattern)
     
@@ -6,6 +6,7 @@ Script para gerar gráficos PNG com comparações de algoritmos de roteamento No
 import os
 import sys
 import re
+import csv
 import matplotlib.pyplot as plt
 import matplotlib.patches as mpatches
 import numpy as np
@@ -14,6 +15,9 @@ from pathlib import Path
 # Configurar matplotlib para não usar interface gráfica
 plt.switch_backend('Agg')
 
+# CSV gerado por bin/results_aggregator a partir de test_outputs/results.nocr
+AGGREGATES_FILE = 'results_aggregates.csv'
+
 class NoCPNGGraphGenerator:
     def __init__(self, test_outputs_dir):
         self.test_outputs_dir = Path(test_outputs_dir)
@@ -102,12 +106,36 @@ class NoCPNGGraphGenerator:
             print(f"Erro ao processar {filepath}: {e}")
             return None
     
+    def parse_aggregates(self, aggregates_file):
+        """Lê as médias entre sementes de cada configuração do CSV agregado"""
+        results = []
+        with open(aggregates_file, 'r', encoding='utf-8', newline='') as f:
+            for row in csv.DictReader(f):
+                algorithm = 'WestFirst' if row['routing'] == 'WEST_FIRST' else row['routing']
+                if algorithm not in self.colors:
+                    continue
+                results.append({
+                    'algorithm': algorithm,
+                    'injection_rate': int(row['rate']),
+                    'mesh_size': f"{row['size']}x{row['size']}",
+                    'latency': float(row['avg_latency_mean']),
+                    'throughput': float(row['throughput_mean']),
+                    'hops': float(row['avg_hops_mean'])
+                })
+        return results
+    
     def load_all_results(self):
         """Carrega todos os resultados dos testes"""
-        print("Carregando resultados dos testes...")
-        
-        for test_file in self.test_outputs_dir.glob('test_*.txt'):
-            result = self.parse_test_file(test_file)
+        aggregates_file = self.test_outputs_dir / AGGREGATES_FILE
+        if aggregates_file.exists():
+            # Resultados já agregados pelo results_aggregator: sem reler os logs
+            print(f"Carregando resultados agregados de {aggregates_file}...")
+            results = self.parse_aggregates(aggregates_file)
+        else:
+            print("Carregando resultados dos testes...")
+            results = [self.parse_test_file(test_file) for test_file in self.test_outputs_dir.glob('test_*.txt')]
+        
+        for result in results:
             if result:
                 mesh_size = result['mesh_size']
                 algorithm = result['algorithm']
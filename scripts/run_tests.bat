@@ -11,7 +11,7 @@ if not exist "test_outputs" mkdir test_outputs
 
 REM Compilar o projeto
 echo [1/4] Compilando projeto...
-mingw32-make
+mingw32-make all tools
 if errorlevel 1 (
     echo ERRO: Falha na compilacao!
     pause
@@ -25,30 +25,63 @@ for /f %%a in ('powershell -Command "Get-Date -Format 'yyyy-MM-dd_HH-mm-ss'"') d
 
 REM Teste 1: XY Routing - Taxa 5%
 echo   - Teste XY (5%% injecao)...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 > "test_outputs\test_XY_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -results test_outputs\results.nocr > "test_outputs\test_XY_5pct_%timestamp%.txt"
 
 REM Teste 2: XY Routing - Taxa 10%
 echo   - Teste XY (10%% injecao)...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 > "test_outputs\test_XY_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -results test_outputs\results.nocr > "test_outputs\test_XY_10pct_%timestamp%.txt"
 
 REM Teste 3: XY Routing - Taxa 20%
 echo   - Teste XY (20%% injecao)...
-.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 > "test_outputs\test_XY_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -results test_outputs\results.nocr > "test_outputs\test_XY_20pct_%timestamp%.txt"
 
 REM Teste 4: West-First Routing - Taxa 5%
 echo   - Teste West-First (5%% injecao)...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 > "test_outputs\test_WestFirst_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_5pct_%timestamp%.txt"
 
 REM Teste 5: West-First Routing - Taxa 10%
 echo   - Teste West-First (10%% injecao)...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 > "test_outputs\test_WestFirst_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_10pct_%timestamp%.txt"
 
 REM Teste 6: West-First Routing - Taxa 20%
 echo   - Teste West-First (20%% injecao)...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 > "test_outputs\test_WestFirst_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_20pct_%timestamp%.txt"
+
+REM Teste 7: Checkpoint - a execução restaurada entrega os mesmos pacotes, na
+REM mesma ordem, que a execução sem interrupção. O checkpoint após o ciclo 200
+REM já inclui as entregas do tempo 201 dos nós; a comparação começa no 202
+echo   - Teste Checkpoint (restauracao identica)...
+set tests_failed=0
+.\bin\noc_simulation.exe -rate 20 -time 400 -seed 7 -checkpoint test_outputs\checkpoint_test.ckpt -checkpoint_at 200 > "test_outputs\test_Checkpoint_full_%timestamp%.txt"
+.\bin\noc_simulation.exe -rate 20 -time 400 -seed 7 -restore test_outputs\checkpoint_test.ckpt > "test_outputs\test_Checkpoint_restored_%timestamp%.txt"
+powershell -NoProfile -Command "$full = Select-String -Path 'test_outputs\test_Checkpoint_full_%timestamp%.txt' -Pattern ' received .* at time (\d+) ' | Where-Object { [int]$_.Matches[0].Groups[1].Value -gt 201 } | ForEach-Object { $_.Line }; $restored = Select-String -Path 'test_outputs\test_Checkpoint_restored_%timestamp%.txt' -Pattern ' received ' | ForEach-Object { $_.Line }; if (-not $full -or -not $restored -or (Compare-Object $full $restored -SyncWindow 0)) { exit 1 }"
+if errorlevel 1 (
+    echo ERRO: Entregas da execucao restaurada diferem da execucao sem interrupcao!
+    set tests_failed=1
+)
+
+REM Teste 8: Execuções em sequência - NoC::reset() entre execuções: a mesma
+REM configuração semeada repetida no arquivo de -runs e rodada sozinha deve
+REM dar o mesmo resumo
+echo   - Teste Execucoes em sequencia (reinicio identico)...
+(
+    echo -rate 30 -seed 3
+    echo -rate 10 -seed 5 -routing WEST_FIRST
+    echo -rate 30 -seed 3
+) > test_outputs\runs_test.txt
+.\bin\noc_simulation.exe -time 300 -runs test_outputs\runs_test.txt > "test_outputs\test_Runs_sequence_%timestamp%.txt"
+.\bin\noc_simulation.exe -time 300 -rate 30 -seed 3 > "test_outputs\test_Runs_single_%timestamp%.txt"
+powershell -NoProfile -Command "$runs = Select-String -Path 'test_outputs\test_Runs_sequence_%timestamp%.txt' -Pattern '^(Network Summary|Scoreboard):' | ForEach-Object { $_.Line }; $single = Select-String -Path 'test_outputs\test_Runs_single_%timestamp%.txt' -Pattern '^(Network Summary|Scoreboard):' | ForEach-Object { $_.Line }; if ($runs.Count -ne 6 -or $single.Count -ne 2 -or $runs[0] -ne $single[0] -or $runs[1] -ne $single[1] -or $runs[4] -ne $single[0] -or $runs[5] -ne $single[1]) { exit 1 }"
+if errorlevel 1 (
+    echo ERRO: Execucao repetida com -runs difere da execucao isolada!
+    set tests_failed=1
+)
 
 echo [3/4] Todos os testes executados!
 
+REM Agregar as execuções entre sementes para os scripts de gráficos
+.\bin\results_aggregator.exe test_outputs\results.nocr
+
 REM Verificar se os arquivos foram criados
 echo [4/4] Verificando resultados...
 set file_count=0
@@ -62,3 +95,8 @@ echo.
 echo Para analisar os resultados, execute:
 echo   mingw32-make analyze
 echo.
+
+if "%tests_failed%"=="1" (
+    echo ERRO: Teste de consistencia falhou, veja as mensagens acima!
+    exit /b 1
+)
@@ -12,7 +12,7 @@ if not exist "test_outputs" mkdir test_outputs
 
 REM Compilar o projeto
 echo [1/3] Compilando projeto...
-mingw32-make
+mingw32-make all tools
 if errorlevel 1 (
     echo ERRO: Falha na compilacao!
     pause
@@ -32,74 +32,74 @@ echo === MALHA 4x4 (16 testes) ===
 REM Malha 4x4 - Taxa 5%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 5%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 4 > "test_outputs\test_XY_4x4_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_5pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 5%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_5pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 10%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 10%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 4 > "test_outputs\test_XY_4x4_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_10pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 10%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_10pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 15%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 15%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 4 > "test_outputs\test_XY_4x4_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_15pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 15%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_15pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 20%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 20%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 4 > "test_outputs\test_XY_4x4_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_20pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 20%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_20pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 25%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 25%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 4 > "test_outputs\test_XY_4x4_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_25pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 25%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_25pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 30%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 30%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 4 > "test_outputs\test_XY_4x4_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_30pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 30%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_30pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 35%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 35%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 35 -time 200 -size 4 > "test_outputs\test_XY_4x4_35pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 35 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_35pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 35%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 35 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_35pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 35 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_35pct_%timestamp%.txt"
 
 REM Malha 4x4 - Taxa 40%
 set /a test_count+=1
 echo   [%test_count%/50] XY 4x4 - 40%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 40 -time 200 -size 4 > "test_outputs\test_XY_4x4_40pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 40 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_XY_4x4_40pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 4x4 - 40%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 40 -time 200 -size 4 > "test_outputs\test_WestFirst_4x4_40pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 40 -time 200 -size 4 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_4x4_40pct_%timestamp%.txt"
 
 echo.
 echo === MALHA 6x6 (12 testes) ===
@@ -107,56 +107,56 @@ echo === MALHA 6x6 (12 testes) ===
 REM Malha 6x6 - Taxa 5%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 5%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 6 > "test_outputs\test_XY_6x6_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_5pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 5%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_5pct_%timestamp%.txt"
 
 REM Malha 6x6 - Taxa 10%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 10%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 6 > "test_outputs\test_XY_6x6_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_10pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 10%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_10pct_%timestamp%.txt"
 
 REM Malha 6x6 - Taxa 15%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 15%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 6 > "test_outputs\test_XY_6x6_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_15pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 15%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_15pct_%timestamp%.txt"
 
 REM Malha 6x6 - Taxa 20%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 20%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 6 > "test_outputs\test_XY_6x6_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_20pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 20%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_20pct_%timestamp%.txt"
 
 REM Malha 6x6 - Taxa 25%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 25%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 6 > "test_outputs\test_XY_6x6_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_25pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 25%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_25pct_%timestamp%.txt"
 
 REM Malha 6x6 - Taxa 30%
 set /a test_count+=1
 echo   [%test_count%/50] XY 6x6 - 30%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 6 > "test_outputs\test_XY_6x6_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_XY_6x6_30pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 6x6 - 30%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 6 > "test_outputs\test_WestFirst_6x6_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 6 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_6x6_30pct_%timestamp%.txt"
 
 echo.
 echo === MALHA 8x8 (12 testes) ===
@@ -164,56 +164,56 @@ echo === MALHA 8x8 (12 testes) ===
 REM Malha 8x8 - Taxa 5%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 5%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 8 > "test_outputs\test_XY_8x8_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_5pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 5%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_5pct_%timestamp%.txt"
 
 REM Malha 8x8 - Taxa 10%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 10%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 8 > "test_outputs\test_XY_8x8_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_10pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 10%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_10pct_%timestamp%.txt"
 
 REM Malha 8x8 - Taxa 15%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 15%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 8 > "test_outputs\test_XY_8x8_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_15pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 15%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_15pct_%timestamp%.txt"
 
 REM Malha 8x8 - Taxa 20%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 20%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 8 > "test_outputs\test_XY_8x8_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 20 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_20pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 20%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_20pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 20 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_20pct_%timestamp%.txt"
 
 REM Malha 8x8 - Taxa 25%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 25%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 8 > "test_outputs\test_XY_8x8_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 25 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_25pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 25%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_25pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 25 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_25pct_%timestamp%.txt"
 
 REM Malha 8x8 - Taxa 30%
 set /a test_count+=1
 echo   [%test_count%/50] XY 8x8 - 30%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 8 > "test_outputs\test_XY_8x8_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 30 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_XY_8x8_30pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 8x8 - 30%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 8 > "test_outputs\test_WestFirst_8x8_30pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 30 -time 200 -size 8 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_8x8_30pct_%timestamp%.txt"
 
 echo.
 echo === MALHA 12x12 (6 testes) ===
@@ -221,29 +221,29 @@ echo === MALHA 12x12 (6 testes) ===
 REM Malha 12x12 - Taxa 5%
 set /a test_count+=1
 echo   [%test_count%/50] XY 12x12 - 5%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 12 > "test_outputs\test_XY_12x12_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_XY_12x12_5pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 12x12 - 5%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 12 > "test_outputs\test_WestFirst_12x12_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_12x12_5pct_%timestamp%.txt"
 
 REM Malha 12x12 - Taxa 10%
 set /a test_count+=1
 echo   [%test_count%/50] XY 12x12 - 10%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 12 > "test_outputs\test_XY_12x12_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_XY_12x12_10pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 12x12 - 10%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 12 > "test_outputs\test_WestFirst_12x12_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_12x12_10pct_%timestamp%.txt"
 
 REM Malha 12x12 - Taxa 15%
 set /a test_count+=1
 echo   [%test_count%/50] XY 12x12 - 15%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 12 > "test_outputs\test_XY_12x12_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 15 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_XY_12x12_15pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 12x12 - 15%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 12 > "test_outputs\test_WestFirst_12x12_15pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 15 -time 200 -size 12 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_12x12_15pct_%timestamp%.txt"
 
 echo.
 echo === MALHA 16x16 (4 testes) ===
@@ -251,24 +251,27 @@ echo === MALHA 16x16 (4 testes) ===
 REM Malha 16x16 - Taxa 5%
 set /a test_count+=1
 echo   [%test_count%/50] XY 16x16 - 5%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 16 > "test_outputs\test_XY_16x16_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 5 -time 200 -size 16 -results test_outputs\results.nocr > "test_outputs\test_XY_16x16_5pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 16x16 - 5%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 16 > "test_outputs\test_WestFirst_16x16_5pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 5 -time 200 -size 16 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_16x16_5pct_%timestamp%.txt"
 
 REM Malha 16x16 - Taxa 10%
 set /a test_count+=1
 echo   [%test_count%/50] XY 16x16 - 10%% injecao...
-.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 16 > "test_outputs\test_XY_16x16_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing XY -rate 10 -time 200 -size 16 -results test_outputs\results.nocr > "test_outputs\test_XY_16x16_10pct_%timestamp%.txt"
 
 set /a test_count+=1
 echo   [%test_count%/50] West-First 16x16 - 10%% injecao...
-.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 16 > "test_outputs\test_WestFirst_16x16_10pct_%timestamp%.txt"
+.\bin\noc_simulation.exe -routing WEST_FIRST -rate 10 -time 200 -size 16 -results test_outputs\results.nocr > "test_outputs\test_WestFirst_16x16_10pct_%timestamp%.txt"
 
 echo.
 echo [3/3] Todos os 50 testes executados!
 
+REM Agregar as execuções entre sementes para os scripts de gráficos
+.\bin\results_aggregator.exe test_outputs\results.nocr
+
 REM Verificar se os arquivos foram criados
 echo === Verificando resultados...
 set file_count=0
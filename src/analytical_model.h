@@ -0,0 +1,310 @@
+#ifndef ANALYTICAL_MODEL_H
+#define ANALYTICAL_MODEL_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "routing_algorithms.h"
+#include "deadlock.h"
+#include "channel.h"
+#include "traffic.h"
+#include "fault_tolerance.h"
+
+// Estimativa analítica de latência e vazão
+//
+// Segue a rota de cada par origem-destino nas mesmas tabelas de roteamento
+// da simulação e soma a carga (pacotes por ciclo) de cada canal: portas de
+// saída entre routers e portas LOCAL de entrega. Cada canal é tratado como
+// uma fila M/G/1 com serviço de flits = ceil(tamanho / largura) ciclos,
+// sorteado com a mistura de tamanhos dos pacotes; a espera média em um canal
+// de utilização rho é rho * E[flits^2] / E[flits] / (2 (1 - rho)), a de uma
+// M/D/1 quando todos os pacotes têm o mesmo tamanho. A latência de um pacote
+// é a de rede vazia medida no simulador (1 mais, por enlace, latência +
+// flits - 1 ciclos, no mínimo 2 nos enlaces em pipeline, e 1 na entrega)
+// somada às esperas do caminho. O canal de maior utilização é o gargalo: com todas as
+// cargas proporcionais à taxa de injeção, a rede satura quando ele chega a 1.
+
+// Resultado da estimativa para uma configuração
+struct PerformanceEstimate {
+    double offered_load;        // Pacotes por ciclo injetados na rede
+    double avg_latency;         // Ciclos, média ponderada pelos fluxos
+    double p50_latency;         // Percentis da latência média de cada fluxo
+    double p95_latency;
+    double p99_latency;
+    double max_latency;
+    double avg_hops;            // Routers atravessados, como no simulador
+    int bottleneck_router;      // Canal mais carregado (-1 sem tráfego)
+    int bottleneck_port;
+    double bottleneck_utilization;
+    double saturation_load;     // Pacotes por ciclo da rede com o gargalo em 100%
+    bool saturated;             // Gargalo em 100% ou mais: latência sem limite
+    std::vector<std::string> caveats;  // Por que o modelo pode errar nesta configuração
+
+    PerformanceEstimate() :
+        offered_load(0), avg_latency(0), p50_latency(0), p95_latency(0), p99_latency(0), max_latency(0),
+        avg_hops(0), bottleneck_router(-1), bottleneck_port(NONE), bottleneck_utilization(0),
+        saturation_load(0), saturated(false) {}
+};
+
+class AnalyticalModel {
+public:
+    AnalyticalModel(int mesh_size_x, int mesh_size_y, const LinkTable& links) :
+        mesh_size_x_(mesh_size_x),
+        mesh_size_y_(mesh_size_y),
+        links_(links),
+        packet_sizes_(1, std::make_pair(static_cast<int>(Packet::SIZE_BYTES), 100)) {}
+
+    // Mistura de tamanhos dos pacotes (bytes, porcentagem); vazia, todos
+    // têm Packet::SIZE_BYTES
+    void setPacketSizes(const std::vector<std::pair<int, int>>& packet_sizes) {
+        packet_sizes_ = packet_sizes;
+        if (packet_sizes_.empty()) {
+            packet_sizes_.push_back(std::make_pair(static_cast<int>(Packet::SIZE_BYTES), 100));
+        }
+    }
+
+    // Tráfego de src para dst, em pacotes por ciclo
+    void addFlow(int src, int dst, double rate) {
+        if (src != dst && rate > 0) {
+            flows_.push_back(Flow{src, dst, rate});
+        }
+    }
+
+    // Tráfego gerado pelos nós: cada nó ativo injeta com probabilidade
+    // injection_rate% por ciclo; no uniforme o destino é qualquer outro nó
+    // ativo, no pedido-resposta um controlador de memória, que devolve uma
+    // resposta por pedido (malha aberta: o limite de pedidos pendentes não
+    // entra no modelo)
+    void addTraffic(const TrafficConfig& traffic, int injection_rate, const std::vector<bool>& active) {
+        double rate = injection_rate / 100.0;
+        std::vector<int> nodes;
+        for (int id = 0; id < static_cast<int>(active.size()); id++) {
+            if (active[id]) {
+                nodes.push_back(id);
+            }
+        }
+
+        if (traffic.mode == TrafficConfig::UNIFORM) {
+            if (nodes.size() < 2) {
+                return;
+            }
+            double pair_rate = rate / (nodes.size() - 1);
+            for (int src : nodes) {
+                for (int dst : nodes) {
+                    addFlow(src, dst, pair_rate);
+                }
+            }
+            return;
+        }
+
+        std::vector<int> controllers;
+        for (int mc : traffic.memory_controllers) {
+            if (mc >= 0 && mc < static_cast<int>(active.size()) && active[mc]) {
+                controllers.push_back(mc);
+            }
+        }
+        if (controllers.empty()) {
+            return;
+        }
+        double pair_rate = rate / controllers.size();
+        for (int src : nodes) {
+            for (int mc : controllers) {
+                addFlow(src, mc, pair_rate);
+                addFlow(mc, src, pair_rate);
+            }
+        }
+    }
+
+    // Calcular a estimativa; false se alguma rota for inválida
+    bool evaluate(const RoutingAlgorithm& routing, PerformanceEstimate& estimate, std::string& error) const {
+        int num_routers = mesh_size_x_ * mesh_size_y_;
+        std::vector<double> load(static_cast<size_t>(num_routers) * 5, 0.0);
+        std::vector<double> service(static_cast<size_t>(num_routers) * 5, 1.0);
+        std::vector<double> residual(static_cast<size_t>(num_routers) * 5, 1.0);  // E[flits^2] / E[flits]
+        std::vector<double> injected(num_routers, 0.0);
+        std::vector<std::vector<int>> paths(flows_.size());
+        std::vector<double> base_latency(flows_.size(), 0.0);
+
+        int max_bytes = 0;
+        for (const auto& size : packet_sizes_) {
+            max_bytes = std::max(max_bytes, size.first);
+        }
+
+        // Rotas, latência de rede vazia e carga dos canais
+        for (size_t f = 0; f < flows_.size(); f++) {
+            const Flow& flow = flows_[f];
+            int current = flow.src;
+            double latency = 1;
+            for (int hops = 0; current != flow.dst; hops++) {
+                int port = routing.calculateOutputPort(
+                    current % mesh_size_x_, current / mesh_size_x_,
+                    flow.dst % mesh_size_x_, flow.dst / mesh_size_x_);
+                int next = neighborRouter(current, port, mesh_size_x_, mesh_size_y_);
+                if (next < 0 || hops > num_routers) {
+                    error = "rota inválida de " + std::to_string(flow.src) + " para " + std::to_string(flow.dst) +
+                            " em R" + std::to_string(current) + " (porta " + directionName(port) + ")";
+                    return false;
+                }
+                LinkConfig link = links_.get(current, next);
+                int min_hop = link.isDirect(max_bytes) ? 1 : 2;
+                double flits = 0;
+                double flits_squared = 0;
+                for (const auto& size : packet_sizes_) {
+                    int size_flits = (size.first + link.width - 1) / link.width;
+                    double share = size.second / 100.0;
+                    flits += size_flits * share;
+                    flits_squared += size_flits * size_flits * share;
+                    latency += std::max(link.latency + size_flits - 1, min_hop) * share;
+                }
+                service[channel(current, port)] = flits;
+                residual[channel(current, port)] = flits_squared / flits;
+                paths[f].push_back(channel(current, port));
+                current = next;
+            }
+            latency += 1;
+            paths[f].push_back(channel(flow.dst, LOCAL));
+            base_latency[f] = latency;
+            injected[flow.src] += flow.rate;
+            for (int c : paths[f]) {
+                load[c] += flow.rate;
+            }
+        }
+
+        // Utilização e espera M/G/1 de cada canal; o gargalo define a saturação
+        estimate = PerformanceEstimate();
+        std::vector<double> wait(load.size(), 0.0);
+        for (size_t c = 0; c < load.size(); c++) {
+            double utilization = load[c] * service[c];
+            if (utilization > estimate.bottleneck_utilization) {
+                estimate.bottleneck_utilization = utilization;
+                estimate.bottleneck_router = static_cast<int>(c / 5);
+                estimate.bottleneck_port = static_cast<int>(c % 5);
+            }
+            wait[c] = queueWait(utilization, residual[c]);
+        }
+        for (double rate : injected) {
+            estimate.offered_load += rate;
+        }
+        if (estimate.bottleneck_utilization > 0) {
+            estimate.saturation_load = estimate.offered_load / estimate.bottleneck_utilization;
+        }
+        estimate.saturated = estimate.bottleneck_utilization >= 1.0;
+        if (estimate.saturated || flows_.empty()) {
+            return true;
+        }
+
+        // Latência de cada fluxo: rede vazia, fila de injeção do nó e esperas do caminho
+        std::vector<std::pair<double, double>> weighted;  // (latência, taxa)
+        double total_latency = 0;
+        double total_hops = 0;
+        for (size_t f = 0; f < flows_.size(); f++) {
+            double latency = base_latency[f] + queueWait(injected[flows_[f].src], 1.0);
+            for (int c : paths[f]) {
+                latency += wait[c];
+            }
+            weighted.push_back(std::make_pair(latency, flows_[f].rate));
+            total_latency += latency * flows_[f].rate;
+            total_hops += paths[f].size() * flows_[f].rate;
+        }
+        estimate.avg_latency = total_latency / estimate.offered_load;
+        estimate.avg_hops = total_hops / estimate.offered_load;
+
+        std::sort(weighted.begin(), weighted.end());
+        estimate.p50_latency = weightedPercentile(weighted, estimate.offered_load, 50);
+        estimate.p95_latency = weightedPercentile(weighted, estimate.offered_load, 95);
+        estimate.p99_latency = weightedPercentile(weighted, estimate.offered_load, 99);
+        estimate.max_latency = weighted.back().first;
+        return true;
+    }
+
+private:
+    struct Flow {
+        int src;
+        int dst;
+        double rate;
+    };
+
+    int mesh_size_x_, mesh_size_y_;
+    LinkTable links_;
+    std::vector<Flow> flows_;
+    std::vector<std::pair<int, int>> packet_sizes_;
+
+    static int channel(int router, int port) { return router * 5 + port; }
+
+    // Espera média na fila M/G/1 com utilização rho e E[S^2] / E[S] = residual
+    // (Pollaczek-Khinchine; com serviço determinístico, residual = serviço)
+    static double queueWait(double utilization, double residual) {
+        if (utilization <= 0) {
+            return 0.0;
+        }
+        return utilization * residual / (2.0 * (1.0 - utilization));
+    }
+
+    static double weightedPercentile(const std::vector<std::pair<double, double>>& sorted, double total, double percent) {
+        double target = percent / 100.0 * total;
+        double seen = 0;
+        for (const auto& entry : sorted) {
+            seen += entry.second;
+            if (seen >= target) {
+                return entry.first;
+            }
+        }
+        return sorted.back().first;
+    }
+};
+
+// Estimar uma configuração da linha de comando: falhas do ciclo 0 aplicadas
+// (com UP_DOWN, as mesmas tabelas que a simulação monta), tráfego e enlaces.
+// Anota em caveats o que o modelo não representa
+inline bool estimateConfiguration(int mesh_size_x, int mesh_size_y, const std::string& routing_algorithm,
+                                  int injection_rate, const TrafficConfig& traffic, const LinkTable& links,
+                                  const FaultSchedule& faults, PerformanceEstimate& estimate, std::string& error) {
+    int num_routers = mesh_size_x * mesh_size_y;
+    MeshFaults static_faults(mesh_size_x, mesh_size_y);
+    bool later_faults = false;
+    for (const FaultEvent& event : faults.getEvents()) {
+        if (event.cycle == 0) {
+            static_faults.apply(event);
+        } else {
+            later_faults = true;
+        }
+    }
+
+    std::unique_ptr<RoutingAlgorithm> routing;
+    std::vector<bool> active(num_routers);
+    if (routing_algorithm == "UP_DOWN") {
+        auto table = std::make_shared<UpDownRoutingTable>();
+        table->rebuild(static_faults);
+        for (int r = 0; r < num_routers; r++) {
+            active[r] = static_faults.isRouterAlive(r) && table->isReachable(r);
+        }
+        routing.reset(new UpDownRoutingAlgorithm(table, mesh_size_x));
+    } else {
+        for (int r = 0; r < num_routers; r++) {
+            active[r] = static_faults.isRouterAlive(r);
+        }
+        routing.reset(createRoutingAlgorithm(routing_algorithm));
+    }
+
+    AnalyticalModel model(mesh_size_x, mesh_size_y, links);
+    model.setPacketSizes(traffic.packet_sizes);
+    model.addTraffic(traffic, injection_rate, active);
+    if (!model.evaluate(*routing, estimate, error)) {
+        return false;
+    }
+
+    if (traffic.mode == TrafficConfig::REQUEST_REPLY) {
+        estimate.caveats.push_back("pedido-resposta em malha fechada modelado como tráfego aberto");
+    }
+    if (later_faults) {
+        estimate.caveats.push_back("falhas durante a simulação não entram no modelo");
+    }
+    if (static_faults.any() && routing_algorithm != "UP_DOWN") {
+        estimate.caveats.push_back("rotas podem atravessar componentes falhos");
+    }
+    return true;
+}
+
+#endif // ANALYTICAL_MODEL_H
@@ -0,0 +1,223 @@
+#ifndef ARBITRATION_H
+#define ARBITRATION_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "packet.h"
+
+// Pedido de uma porta de entrada por uma saída do router
+struct ArbiterRequest {
+    int input_port;        // Porta de entrada que pede a saída
+    const Packet* packet;  // Pacote na cabeça do buffer dessa entrada
+};
+
+// Classe base para políticas de arbitragem das saídas do router.
+// O estado (ponteiros de rodízio, créditos) é mantido por saída: cada
+// combinação (porta de saída, classe de mensagem) do router é um slot.
+class Arbiter {
+public:
+    explicit Arbiter(int num_slots) : last_port_(num_slots, -1) {}
+    virtual ~Arbiter() {}
+
+    // Escolher um dos count pedidos (count >= 1) para a saída output_slot;
+    // retorna o índice do vencedor em requests
+    virtual int select(int output_slot, const ArbiterRequest* requests, int count) = 0;
+
+    // Obter nome da política
+    virtual std::string getName() const = 0;
+
+    // Estado interno como lista de inteiros (checkpoint); setState retorna
+    // false se a lista não corresponde a esta política
+    virtual std::vector<int> getState() const { return last_port_; }
+
+    virtual bool setState(const std::vector<int>& state) {
+        if (state.size() != last_port_.size()) {
+            return false;
+        }
+        last_port_ = state;
+        return true;
+    }
+
+protected:
+    std::vector<int> last_port_;  // Última entrada atendida em cada saída
+
+    // Rodízio entre os pedidos aceitos por eligible: vence a primeira porta após
+    // a última atendida nesta saída; retorna -1 se nenhum pedido for elegível
+    template <typename Eligible>
+    int roundRobin(int output_slot, const ArbiterRequest* requests, int count, Eligible eligible) {
+        int best = -1;
+        int best_distance = 0;
+        for (int i = 0; i < count; i++) {
+            if (!eligible(requests[i])) {
+                continue;
+            }
+            int distance = (requests[i].input_port - last_port_[output_slot] + 9) % 5;
+            if (best < 0 || distance < best_distance) {
+                best = i;
+                best_distance = distance;
+            }
+        }
+        if (best >= 0) {
+            last_port_[output_slot] = requests[best].input_port;
+        }
+        return best;
+    }
+};
+
+// Prioridade fixa pela ordem das portas (NORTE, LESTE, SUL, OESTE, LOCAL)
+class FixedOrderArbiter : public Arbiter {
+public:
+    explicit FixedOrderArbiter(int num_slots) : Arbiter(num_slots) {}
+
+    int select(int, const ArbiterRequest* requests, int count) override {
+        int best = 0;
+        for (int i = 1; i < count; i++) {
+            if (requests[i].input_port < requests[best].input_port) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    std::string getName() const override {
+        return "Fixed Port Order";
+    }
+};
+
+// Prioridade estrita pela classe de tráfego; empates em rodízio
+class StrictPriorityArbiter : public Arbiter {
+public:
+    explicit StrictPriorityArbiter(int num_slots) : Arbiter(num_slots) {}
+
+    int select(int output_slot, const ArbiterRequest* requests, int count) override {
+        int highest = 0;
+        for (int i = 0; i < count; i++) {
+            if (requests[i].packet->getTrafficClass() > highest) {
+                highest = requests[i].packet->getTrafficClass();
+            }
+        }
+        return roundRobin(output_slot, requests, count, [highest](const ArbiterRequest& request) {
+            return request.packet->getTrafficClass() == highest;
+        });
+    }
+
+    std::string getName() const override {
+        return "Strict Priority";
+    }
+};
+
+// Rodízio ponderado: cada classe de tráfego recebe até weights[classe] concessões
+// seguidas por saída antes de passar a vez; classes sem pedidos são puladas
+class WeightedRoundRobinArbiter : public Arbiter {
+public:
+    WeightedRoundRobinArbiter(int num_slots, const std::vector<int>& weights) :
+        Arbiter(num_slots),
+        weights_(weights),
+        current_class_(num_slots, Packet::NUM_TRAFFIC_CLASSES - 1),
+        remaining_(num_slots, 0) {}
+
+    int select(int output_slot, const ArbiterRequest* requests, int count) override {
+        for (int k = 0; k <= Packet::NUM_TRAFFIC_CLASSES; k++) {
+            int traffic_class = current_class_[output_slot];
+            if (remaining_[output_slot] > 0) {
+                int winner = roundRobin(output_slot, requests, count, [traffic_class](const ArbiterRequest& request) {
+                    return request.packet->getTrafficClass() == traffic_class;
+                });
+                if (winner >= 0) {
+                    remaining_[output_slot]--;
+                    return winner;
+                }
+            }
+
+            // Passar para a próxima classe (da mais prioritária para a menos)
+            traffic_class = (traffic_class + Packet::NUM_TRAFFIC_CLASSES - 1) % Packet::NUM_TRAFFIC_CLASSES;
+            current_class_[output_slot] = traffic_class;
+            remaining_[output_slot] = weights_[traffic_class];
+        }
+        return roundRobin(output_slot, requests, count, [](const ArbiterRequest&) { return true; });
+    }
+
+    std::string getName() const override {
+        std::string name = "Weighted Round-Robin (";
+        for (size_t c = 0; c < weights_.size(); c++) {
+            name += (c > 0 ? "," : "") + std::to_string(weights_[c]);
+        }
+        return name + ")";
+    }
+
+    // Rodízio de entradas seguido da classe atual e das concessões restantes de cada saída
+    std::vector<int> getState() const override {
+        std::vector<int> state = last_port_;
+        state.insert(state.end(), current_class_.begin(), current_class_.end());
+        state.insert(state.end(), remaining_.begin(), remaining_.end());
+        return state;
+    }
+
+    bool setState(const std::vector<int>& state) override {
+        size_t n = last_port_.size();
+        if (state.size() != 3 * n) {
+            return false;
+        }
+        last_port_.assign(state.begin(), state.begin() + n);
+        current_class_.assign(state.begin() + n, state.begin() + 2 * n);
+        remaining_.assign(state.begin() + 2 * n, state.end());
+        return true;
+    }
+
+private:
+    std::vector<int> weights_;        // Concessões por vez de cada classe de tráfego
+    std::vector<int> current_class_;  // Classe atendida em cada saída
+    std::vector<int> remaining_;      // Concessões restantes da classe atual
+};
+
+// Mais antigo primeiro pelo tempo de criação; empates em rodízio
+class OldestFirstArbiter : public Arbiter {
+public:
+    explicit OldestFirstArbiter(int num_slots) : Arbiter(num_slots) {}
+
+    int select(int output_slot, const ArbiterRequest* requests, int count) override {
+        int oldest = requests[0].packet->getCreationTime();
+        for (int i = 1; i < count; i++) {
+            if (requests[i].packet->getCreationTime() < oldest) {
+                oldest = requests[i].packet->getCreationTime();
+            }
+        }
+        return roundRobin(output_slot, requests, count, [oldest](const ArbiterRequest& request) {
+            return request.packet->getCreationTime() == oldest;
+        });
+    }
+
+    std::string getName() const override {
+        return "Oldest First";
+    }
+};
+
+// Pesos padrão do rodízio ponderado: dobram a cada classe de tráfego
+inline std::vector<int> defaultArbiterWeights() {
+    std::vector<int> weights;
+    for (int c = 0; c < Packet::NUM_TRAFFIC_CLASSES; c++) {
+        weights.push_back(1 << c);
+    }
+    return weights;
+}
+
+// Função para criar políticas de arbitragem
+inline Arbiter* createArbiter(const std::string& arbitration_name, int num_slots,
+                              const std::vector<int>& weights = defaultArbiterWeights()) {
+    if (arbitration_name == "FIXED") {
+        return new FixedOrderArbiter(num_slots);
+    } else if (arbitration_name == "PRIORITY") {
+        return new StrictPriorityArbiter(num_slots);
+    } else if (arbitration_name == "WRR") {
+        return new WeightedRoundRobinArbiter(num_slots, weights);
+    } else if (arbitration_name == "OLDEST_FIRST") {
+        return new OldestFirstArbiter(num_slots);
+    }
+
+    // Padrão para a ordem fixa das portas
+    std::cout << "Aviso: Política de arbitragem desconhecida. Usando ordem fixa das portas." << std::endl;
+    return new FixedOrderArbiter(num_slots);
+}
+
+#endif // ARBITRATION_H
@@ -2,67 +2,368 @@
 #define CHANNEL_H
 
 #include <systemc.h>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 #include "packet.h"
 
+// Configuração de um enlace entre dois routers
+struct LinkConfig {
+    int latency;       // Ciclos para atravessar o enlace (1 = fio direto, sem Channel)
+    int credit_delay;  // Ciclos para o crédito de uma vaga liberada voltar ao remetente
+    int width;         // Largura do enlace em bytes transferidos por ciclo
+
+    LinkConfig(int latency = 1, int credit_delay = 0, int width = Packet::SIZE_BYTES) :
+        latency(latency),
+        credit_delay(credit_delay),
+        width(width) {}
+
+    // Um enlace de 1 ciclo, sem atraso de crédito e largo o bastante para o
+    // maior pacote em um ciclo equivale à conexão direta por sinais
+    bool isDirect(int max_packet_bytes = Packet::SIZE_BYTES) const {
+        return latency <= 1 && credit_delay == 0 && width >= max_packet_bytes;
+    }
+};
+
+// Tabela de configuração dos enlaces: um padrão global e exceções por par de routers
+class LinkTable {
+public:
+    LinkTable(const LinkConfig& default_config = LinkConfig()) :
+        default_config_(default_config) {}
+
+    const LinkConfig& getDefault() const { return default_config_; }
+    void setDefault(const LinkConfig& config) { default_config_ = config; }
+
+    // Configurar o enlace entre dois routers (ambos os sentidos)
+    void setLink(int router_a, int router_b, const LinkConfig& config) {
+        overrides_[std::make_pair(router_a, router_b)] = config;
+        overrides_[std::make_pair(router_b, router_a)] = config;
+    }
+
+    // Obter a configuração do enlace from -> to
+    LinkConfig get(int from, int to) const {
+        auto it = overrides_.find(std::make_pair(from, to));
+        return it != overrides_.end() ? it->second : default_config_;
+    }
+
+    // Todos os enlaces são conexões diretas de 1 ciclo
+    bool allDirect(int max_packet_bytes = Packet::SIZE_BYTES) const {
+        if (!default_config_.isDirect(max_packet_bytes)) {
+            return false;
+        }
+        for (const auto& entry : overrides_) {
+            if (!entry.second.isDirect(max_packet_bytes)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Carregar exceções de um arquivo com linhas "router_a router_b latência largura [atraso_crédito]";
+    // linhas vazias e iniciadas por '#' são ignoradas
+    bool loadFromFile(const std::string& filename, std::string& error) {
+        std::ifstream in(filename);
+        if (!in) {
+            error = "não foi possível abrir " + filename;
+            return false;
+        }
+
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line)) {
+            line_number++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            int router_a, router_b;
+            LinkConfig config(1, default_config_.credit_delay, default_config_.width);
+            if (!(fields >> router_a >> router_b >> config.latency >> config.width)) {
+                error = filename + ":" + std::to_string(line_number) + ": linha inválida";
+                return false;
+            }
+            fields >> config.credit_delay;
+
+            if (config.latency < 1 || config.width < 1 || config.credit_delay < 0) {
+                error = filename + ":" + std::to_string(line_number) + ": valores fora do intervalo";
+                return false;
+            }
+            setLink(router_a, router_b, config);
+        }
+        return true;
+    }
+
+private:
+    LinkConfig default_config_;
+    std::map<std::pair<int, int>, LinkConfig> overrides_;
+};
+
 // Classe Channel para comunicação NoC
+//
+// Enlace em pipeline com controle de fluxo por créditos: cada classe de
+// mensagem tem um crédito por vaga no buffer do destino mais um por estágio
+// do fio. O crédito é consumido quando o pacote entra no enlace e só volta
+// quando o router de destino libera a vaga no buffer, atraso_crédito ciclos
+// depois; um caminho de volta mais longo reduz a vazão do enlace. Um pacote escrito pelo remetente no ciclo t fica visível ao destino no ciclo
+// t + latência + (flits - 1), com flits = ceil(tamanho / largura), e ocupa a
+// entrada do enlace por flits ciclos. A latência mínima pelo Channel é de
+// 2 ciclos; enlaces de 1 ciclo e largura total usam sinais diretos. Cada
+// classe tem fila e créditos próprios, como os buffers dos routers.
 class Channel : public sc_module {
 public:
+    static const int NUM_CLASSES = Packet::NUM_MESSAGE_CLASSES;
+
     // Portas de entrada e saída
     sc_in<bool> clk;
     sc_in<Packet> in_packet;    // Pacote de entrada
     sc_in<bool> in_valid;       // Sinal de validade da entrada
-    sc_out<bool> in_ready;      // Sinal de pronto da entrada
-    
+    sc_out<int> in_ready;       // Máscara de classes com crédito na entrada
+
     sc_out<Packet> out_packet;  // Pacote de saída
     sc_out<bool> out_valid;     // Sinal de validade da saída
-    sc_in<bool> out_ready;      // Sinal de pronto da saída
-
-    // Estado do canal
-    bool busy;
-    Packet buffer;
-    int delay;
-    int delay_counter;
+    sc_in<int> out_ready;       // Máscara de classes aceitas pelo destino
+    sc_in<int> credit_in;       // Vagas liberadas pelo destino no ciclo anterior (Packet::classCount)
 
-    // Construtor
-    Channel(sc_module_name name, int transmission_delay = 1) : 
+    // Construtor; buffer_slots é o tamanho do buffer de entrada do destino, por classe
+    Channel(sc_module_name name, int transmission_delay = 2, int credit_delay = 0,
+            int width = Packet::SIZE_BYTES, int buffer_slots = 4) :
         sc_module(name),
-        busy(false),
-        delay(transmission_delay),
-        delay_counter(0) {
-        
+        delay(transmission_delay < 1 ? 1 : transmission_delay),
+        credit_delay(credit_delay),
+        width(width < 1 ? 1 : width),
+        buffer_slots(buffer_slots < 1 ? 1 : buffer_slots),
+        cycle(0),
+        next_accept_cycle(0),
+        out_class(-1),
+        next_out_class(0) {
+
+        reset();
+
         // Registrar processos
         SC_METHOD(process);
         sensitive << clk.pos();
+        dont_initialize();
     }
 
     // Método de processo
     void process() {
-        // Sempre sinalizar se estamos prontos para receber
-        in_ready.write(!busy);
-        
-        // Se não estamos ocupados e há uma entrada válida, aceitar
-        if (!busy && in_valid.read()) {
-            buffer = in_packet.read();
-            busy = true;
-            delay_counter = delay;
-        }
-        
-        // Se ocupado, decrementar contador de atraso
-        if (busy) {
-            if (delay_counter > 0) {
-                delay_counter--;
+        cycle++;
+
+        // Liberar a saída quando o destino aceitou; o pacote passa a ocupar a
+        // vaga do buffer do destino, e o crédito fica com ele
+        if (out_class >= 0 && (out_ready.read() & Packet::classMask(out_class))) {
+            pipeline[out_class].pop_front();
+            out_class = -1;
+        }
+
+        // Vagas liberadas pelo destino: o crédito volta após credit_delay
+        int freed = credit_in.read();
+        for (int c = 0; c < NUM_CLASSES && freed != 0; c++) {
+            for (int k = Packet::countOfClass(freed, c); k > 0; k--) {
+                credit_returns.push_back(CreditReturn{cycle + credit_delay, c});
             }
-            
-            // Se o atraso terminou e a saída está pronta, enviar o pacote
-            if (delay_counter == 0 && out_ready.read()) {
-                out_packet.write(buffer);
-                out_valid.write(true);
-                busy = false;
+        }
+
+        // Recolher créditos que completaram a volta
+        while (!credit_returns.empty() && credit_returns.front().cycle <= cycle) {
+            credits[credit_returns.front().message_class]++;
+            credit_returns.pop_front();
+        }
+
+        // Aceitar um pacote se anunciamos pronto para sua classe no ciclo anterior
+        if (in_valid.read()) {
+            Packet packet = in_packet.read();
+            int message_class = packet.getMessageClass();
+            if (in_ready.read() & Packet::classMask(message_class)) {
+                int flits = (packet.getSizeBytes() + width - 1) / width;
+
+                // Os registradores de entrada e saída do Channel já contam 2 ciclos;
+                // a serialização dos flits restantes soma-se à latência do fio
+                InFlight entry;
+                entry.packet = packet;
+                entry.ready_cycle = cycle + (flits - 1) + (delay - 2);
+                if (entry.ready_cycle < cycle) {
+                    entry.ready_cycle = cycle;
+                }
+                pipeline[message_class].push_back(entry);
+
+                credits[message_class]--;
+                next_accept_cycle = cycle + flits;
             }
-        } else {
+        }
+
+        // Enviar a cabeça de uma classe quando o atraso terminou, preferindo as
+        // classes aceitas pelo destino; o pacote sai da fila só quando aceito
+        int chosen = -1;
+        for (int k = 0; k < NUM_CLASSES && chosen < 0; k++) {
+            int c = (next_out_class + k) % NUM_CLASSES;
+            if (headReady(c) && (out_ready.read() & Packet::classMask(c))) {
+                chosen = c;
+            }
+        }
+        if (chosen < 0) {
+            chosen = out_class;
+        }
+        for (int c = 0; c < NUM_CLASSES && chosen < 0; c++) {
+            if (headReady(c)) {
+                chosen = c;
+            }
+        }
+
+        if (chosen < 0) {
             out_valid.write(false);
+        } else if (chosen != out_class) {
+            out_packet.write(pipeline[chosen].front().packet);
+            out_valid.write(true);
+            out_class = chosen;
+            next_out_class = (chosen + 1) % NUM_CLASSES;
+        }
+
+        // Sinalizar para quais classes podemos receber no próximo ciclo
+        int ready_mask = 0;
+        if (cycle + 1 >= next_accept_cycle) {
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                if (credits[c] > 0) {
+                    ready_mask |= Packet::classMask(c);
+                }
+            }
+        }
+        in_ready.write(ready_mask);
+    }
+
+    // Adicionar à lista os IDs dos pacotes em trânsito no enlace
+    void collectInFlightIds(std::vector<long long>& ids) const {
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            for (const InFlight& entry : pipeline[c]) {
+                ids.push_back(entry.packet.getId());
+            }
+        }
+    }
+
+    // Pacote da classe que já chegou ao fim do enlace e espera o destino (nullptr se nenhum)
+    const Packet* getHeadPacket(int message_class) const {
+        return headReady(message_class) ? &pipeline[message_class].front().packet : nullptr;
+    }
+
+    // Há pacote ainda atravessando o fio ou sendo serializado
+    bool hasPacketInTransit() const {
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            for (const InFlight& entry : pipeline[c]) {
+                if (entry.ready_cycle > cycle) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Obter número de pacotes em trânsito no enlace
+    int getInFlight() const {
+        int in_flight = 0;
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            in_flight += static_cast<int>(pipeline[c].size());
         }
+        return in_flight;
+    }
+
+    // Esvaziar o enlace e devolver todos os créditos (reinício da rede)
+    void reset() {
+        cycle = 0;
+        next_accept_cycle = 0;
+        out_class = -1;
+        next_out_class = 0;
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            credits[c] = buffer_slots + delay;
+            pipeline[c].clear();
+        }
+        credit_returns.clear();
+    }
+
+    // Gravar e restaurar filas, créditos e ciclo do enlace (checkpoint)
+    void saveState(CheckpointWriter& out) const {
+        out.writeInt(cycle);
+        out.writeInt(next_accept_cycle);
+        out.writeInt(out_class);
+        out.writeInt(next_out_class);
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            out.writeInt(credits[c]);
+            out.writeUnsigned(pipeline[c].size());
+            for (const InFlight& entry : pipeline[c]) {
+                entry.packet.saveState(out);
+                out.writeInt(entry.ready_cycle);
+            }
+        }
+        out.writeUnsigned(credit_returns.size());
+        for (const CreditReturn& credit : credit_returns) {
+            out.writeInt(credit.cycle);
+            out.writeInt(credit.message_class);
+        }
+    }
+
+    void loadState(CheckpointReader& in) {
+        cycle = in.readInt();
+        next_accept_cycle = in.readInt();
+        out_class = static_cast<int>(in.readInt());
+        next_out_class = static_cast<int>(in.readInt());
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            credits[c] = static_cast<int>(in.readInt());
+            pipeline[c].assign(in.readSize(), InFlight());
+            for (InFlight& entry : pipeline[c]) {
+                entry.packet.loadState(in);
+                entry.ready_cycle = in.readInt();
+            }
+        }
+        credit_returns.assign(in.readSize(), CreditReturn());
+        for (CreditReturn& credit : credit_returns) {
+            credit.cycle = in.readInt();
+            credit.message_class = static_cast<int>(in.readInt());
+            if (credit.message_class < 0 || credit.message_class >= NUM_CLASSES) {
+                in.fail();
+                credit.message_class = 0;
+            }
+        }
+        if (out_class < -1 || out_class >= NUM_CLASSES || next_out_class < 0 || next_out_class >= NUM_CLASSES) {
+            in.fail();
+            out_class = -1;
+            next_out_class = 0;
+        }
+    }
+
+private:
+    // Pacote em trânsito e ciclo a partir do qual pode sair do enlace
+    struct InFlight {
+        Packet packet;
+        long long ready_cycle;
+    };
+
+    // Crédito a caminho do remetente
+    struct CreditReturn {
+        long long cycle;
+        int message_class;
+    };
+
+    // Estado do canal
+    int delay;
+    int credit_delay;
+    int width;
+    int buffer_slots;                     // Vagas do buffer do destino, por classe
+    int credits[NUM_CLASSES];             // Vagas livres vistas pelo remetente, por classe
+    long long cycle;
+    long long next_accept_cycle;          // Entrada ocupada até a serialização terminar
+    int out_class;                        // Classe apresentada na saída e ainda não aceita (-1 se nenhuma)
+    int next_out_class;                   // Próxima classe no rodízio da saída
+    std::deque<InFlight> pipeline[NUM_CLASSES];  // Pacotes em trânsito por classe
+    std::deque<CreditReturn> credit_returns;     // Créditos voltando ao remetente
+
+    // A cabeça da fila da classe já atravessou o enlace
+    bool headReady(int message_class) const {
+        return !pipeline[message_class].empty() && pipeline[message_class].front().ready_cycle <= cycle;
     }
 };
 
-#endif // CHANNEL_H
\ No newline at end of file
+#endif // CHANNEL_H
@@ -0,0 +1,193 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Codificação binária compacta dos checkpoints
+//
+// Todo inteiro é gravado como varint (LEB128, 7 bits por byte), com os
+// valores com sinal em zigue-zague: contadores, IDs e ciclos pequenos ocupam
+// 1 ou 2 bytes. Cada componente grava e lê seus campos na mesma ordem em
+// saveState/loadState; o arquivo só traz um cabeçalho com a estrutura da rede.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::ostream& out) : out_(out) {}
+
+    void writeUnsigned(uint64_t value) {
+        while (value >= 0x80) {
+            out_.put(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out_.put(static_cast<char>(value));
+    }
+
+    void writeInt(long long value) {
+        uint64_t bits = static_cast<uint64_t>(value);
+        writeUnsigned((bits << 1) ^ (value < 0 ? ~uint64_t(0) : 0));
+    }
+
+    void writeBool(bool value) { out_.put(value ? 1 : 0); }
+
+    // Reais em 8 bytes fixos (bits do IEEE 754, byte menos significativo primeiro)
+    void writeDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < 8; i++) {
+            out_.put(static_cast<char>((bits >> (8 * i)) & 0xff));
+        }
+    }
+
+    void writeString(const std::string& value) {
+        writeUnsigned(value.size());
+        out_.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void writeInts(const std::vector<int>& values) {
+        writeUnsigned(values.size());
+        for (int value : values) {
+            writeInt(value);
+        }
+    }
+
+    void writeUnsigneds(const std::vector<uint64_t>& values) {
+        writeUnsigned(values.size());
+        for (uint64_t value : values) {
+            writeUnsigned(value);
+        }
+    }
+
+    // Estado completo do gerador (624 palavras e a posição), como varints
+    void writeRng(const std::mt19937& rng) {
+        std::ostringstream text;
+        text << rng;
+        std::istringstream words(text.str());
+        std::vector<uint64_t> values;
+        uint64_t word;
+        while (words >> word) {
+            values.push_back(word);
+        }
+        writeUnsigneds(values);
+    }
+
+    bool ok() const { return static_cast<bool>(out_); }
+
+private:
+    std::ostream& out_;
+};
+
+// Leitura na ordem da gravação; um erro (fim do arquivo, valor incoerente)
+// fica registrado e as leituras seguintes devolvem zero
+class CheckpointReader {
+public:
+    explicit CheckpointReader(std::istream& in) : in_(in), ok_(true) {}
+
+    uint64_t readUnsigned() {
+        uint64_t value = 0;
+        for (int shift = 0; ok_ && shift < 64; shift += 7) {
+            int byte = in_.get();
+            if (byte == std::char_traits<char>::eof()) {
+                ok_ = false;
+                break;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    long long readInt() {
+        uint64_t bits = readUnsigned();
+        return static_cast<long long>((bits >> 1) ^ (~(bits & 1) + 1));
+    }
+
+    bool readBool() { return readUnsigned() != 0; }
+
+    double readDouble() {
+        uint64_t bits = 0;
+        for (int i = 0; ok_ && i < 8; i++) {
+            int byte = in_.get();
+            if (byte == std::char_traits<char>::eof()) {
+                ok_ = false;
+                break;
+            }
+            bits |= static_cast<uint64_t>(byte) << (8 * i);
+        }
+        double value = 0;
+        if (ok_) {
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+        return value;
+    }
+
+    std::string readString() {
+        uint64_t size = readUnsigned();
+        if (!ok_ || size > MAX_SIZE) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string value(static_cast<size_t>(size), '\0');
+        in_.read(&value[0], static_cast<std::streamsize>(size));
+        ok_ = ok_ && static_cast<bool>(in_);
+        return value;
+    }
+
+    std::vector<int> readInts() {
+        std::vector<int> values(readSize());
+        for (int& value : values) {
+            value = static_cast<int>(readInt());
+        }
+        return values;
+    }
+
+    std::vector<uint64_t> readUnsigneds() {
+        std::vector<uint64_t> values(readSize());
+        for (uint64_t& value : values) {
+            value = readUnsigned();
+        }
+        return values;
+    }
+
+    void readRng(std::mt19937& rng) {
+        std::vector<uint64_t> values = readUnsigneds();
+        std::ostringstream text;
+        for (uint64_t value : values) {
+            text << value << " ";
+        }
+        std::istringstream words(text.str());
+        if (!(words >> rng)) {
+            ok_ = false;
+        }
+    }
+
+    // Tamanho de uma sequência, limitado para não alocar a partir de lixo
+    size_t readSize() {
+        uint64_t size = readUnsigned();
+        if (size > MAX_SIZE) {
+            ok_ = false;
+            return 0;
+        }
+        return static_cast<size_t>(size);
+    }
+
+    // Registrar incoerência encontrada por quem lê (ex.: estrutura diferente)
+    void fail() { ok_ = false; }
+    bool ok() const { return ok_; }
+
+private:
+    static const uint64_t MAX_SIZE = 1u << 28;
+
+    std::istream& in_;
+    bool ok_;
+};
+
+#endif // CHECKPOINT_H
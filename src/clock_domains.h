@@ -0,0 +1,478 @@
+#ifndef CLOCK_DOMAINS_H
+#define CLOCK_DOMAINS_H
+
+#include <systemc.h>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "packet.h"
+
+// Configuração de domínios de clock
+//
+// Cada router pertence a um domínio (0 por padrão, com o período de
+// referência de 1 ns) e cada nó ao domínio do seu router, a menos que seja
+// colocado em outro (modelo nó vs. rede). Enlaces entre domínios diferentes
+// passam por FIFOs de sincronização. O período de um domínio pode mudar
+// durante a simulação (DVFS).
+struct ClockDomainConfig {
+    // Mudança de frequência de um domínio no instante time_ns
+    struct DvfsEvent {
+        int domain;
+        double time_ns;
+        double period_ns;
+    };
+
+    std::vector<double> periods_ns;    // Período inicial de cada domínio (índice = ID)
+    std::vector<int> router_domains;   // Domínio de cada router
+    std::vector<int> node_domains;     // Domínio de cada nó
+    std::vector<DvfsEvent> dvfs_events;
+    int sync_stages;                   // Ciclos do destino para atravessar a fronteira
+    int fifo_depth;                    // Entradas por classe em cada FIFO de sincronização
+
+    ClockDomainConfig() :
+        sync_stages(2),
+        fifo_depth(6) {}
+
+    // Há mais de um clock ou DVFS: caso contrário a rede usa o clock único do NoC
+    bool isMultiClock() const {
+        return periods_ns.size() > 1 || !dvfs_events.empty() ||
+               (!periods_ns.empty() && periods_ns[0] != 1.0);
+    }
+
+    int getNumDomains() const { return static_cast<int>(periods_ns.size()); }
+    int routerDomain(int router) const { return router_domains.empty() ? 0 : router_domains[router]; }
+    int nodeDomain(int node) const { return node_domains.empty() ? 0 : node_domains[node]; }
+
+    // Carregar de um arquivo com linhas:
+    //   domain ID PERÍODO_NS           define um domínio (0 já existe com 1 ns)
+    //   routers ID LISTA               routers (e seus nós) no domínio
+    //   nodes ID LISTA|all             só os nós, separados dos seus routers
+    //   dvfs ID TEMPO_NS PERÍODO_NS    troca o período do domínio durante a simulação
+    //   crossing ESTÁGIOS PROFUNDIDADE sincronizadores e profundidade das FIFOs
+    // Linhas vazias e iniciadas por '#' são ignoradas.
+    bool loadFromFile(const std::string& filename, int num_routers, std::string& error) {
+        std::ifstream in(filename);
+        if (!in) {
+            error = "não foi possível abrir " + filename;
+            return false;
+        }
+
+        periods_ns.assign(1, 1.0);
+        router_domains.assign(num_routers, 0);
+        node_domains.assign(num_routers, -1);
+
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line)) {
+            line_number++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string kind;
+            fields >> kind;
+            std::string where = filename + ":" + std::to_string(line_number) + ": ";
+
+            if (kind == "domain") {
+                int id;
+                double period;
+                if (!(fields >> id >> period) || id < 0 || period <= 0) {
+                    error = where + "domínio inválido";
+                    return false;
+                }
+                if (id >= getNumDomains()) {
+                    periods_ns.resize(id + 1, 0.0);
+                }
+                periods_ns[id] = period;
+            } else if (kind == "routers" || kind == "nodes") {
+                int id;
+                std::string list;
+                if (!(fields >> id >> list) || !isDefined(id)) {
+                    error = where + "domínio não definido";
+                    return false;
+                }
+                std::vector<int> members;
+                if (kind == "nodes" && list == "all") {
+                    for (int n = 0; n < num_routers; n++) {
+                        members.push_back(n);
+                    }
+                } else if (!parseList(list, num_routers, members)) {
+                    error = where + "lista inválida: " + list;
+                    return false;
+                }
+                for (int member : members) {
+                    (kind == "routers" ? router_domains : node_domains)[member] = id;
+                }
+            } else if (kind == "dvfs") {
+                DvfsEvent event;
+                if (!(fields >> event.domain >> event.time_ns >> event.period_ns) ||
+                    !isDefined(event.domain) || event.time_ns < 0 || event.period_ns <= 0) {
+                    error = where + "evento DVFS inválido";
+                    return false;
+                }
+                dvfs_events.push_back(event);
+            } else if (kind == "crossing") {
+                if (!(fields >> sync_stages >> fifo_depth) || sync_stages < 1 || fifo_depth < 1) {
+                    error = where + "estágios e profundidade devem ser positivos";
+                    return false;
+                }
+            } else {
+                error = where + "linha inválida";
+                return false;
+            }
+        }
+
+        for (int id = 0; id < getNumDomains(); id++) {
+            if (!isDefined(id)) {
+                error = "domínio " + std::to_string(id) + " sem período";
+                return false;
+            }
+        }
+
+        // Nós sem domínio próprio seguem o seu router
+        for (int n = 0; n < num_routers; n++) {
+            if (node_domains[n] < 0) {
+                node_domains[n] = router_domains[n];
+            }
+        }
+        std::stable_sort(dvfs_events.begin(), dvfs_events.end(), [](const DvfsEvent& a, const DvfsEvent& b) {
+            return a.time_ns < b.time_ns;
+        });
+        return true;
+    }
+
+private:
+    bool isDefined(int id) const {
+        return id >= 0 && id < getNumDomains() && periods_ns[id] > 0;
+    }
+
+    static bool parseList(const std::string& text, int limit, std::vector<int>& values) {
+        std::istringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            std::istringstream field(item);
+            int value;
+            if (!(field >> value) || value < 0 || value >= limit) {
+                return false;
+            }
+            values.push_back(value);
+        }
+        return !values.empty();
+    }
+};
+
+// Gerador de clock com período ajustável em tempo de execução (DVFS)
+//
+// O sc_clock tem período fixo; este módulo gera as bordas com uma thread e
+// aplica cada novo período na próxima borda de subida, sem glitches. Os
+// instantes das trocas contam a partir da origem, que um reinício da rede
+// move para a borda de subida em que a nova execução começa.
+class ClockGenerator : public sc_module {
+public:
+    sc_signal<bool> clk;    // Clock do domínio
+
+    ClockGenerator(sc_module_name name, int domain, const sc_time& period) :
+        sc_module(name),
+        domain_(domain),
+        initial_period_(period),
+        period_(period),
+        origin_(SC_ZERO_TIME),
+        cycles_(0),
+        next_event_(0),
+        restart_pending_(false) {
+
+        SC_THREAD(generate);
+    }
+
+    // Agendar uma troca de período no instante dado (em ordem crescente)
+    void scheduleChange(const sc_time& time, const sc_time& period) {
+        changes_.push_back(Change{time, period});
+    }
+
+    // Voltar ao período inicial e reagendar as trocas a partir de origin, onde
+    // o clock terá uma borda de subida (reinício da rede, com a simulação parada)
+    void restart(const sc_time& origin) {
+        period_ = initial_period_;
+        origin_ = origin;
+        cycles_ = 0;
+        next_event_ = 0;
+        restart_pending_ = true;
+        restart_event_.notify(SC_ZERO_TIME);
+    }
+
+    const sc_time& getPeriod() const { return period_; }
+    long long getCycles() const { return cycles_; }
+
+    // Período médio desde o início (varia com DVFS)
+    double getAveragePeriodNs() const {
+        return cycles_ > 0 ? (sc_time_stamp() - origin_).to_seconds() * 1e9 / cycles_ : period_.to_seconds() * 1e9;
+    }
+
+    void generate() {
+        while (true) {
+            // Aplicar trocas de período vencidas antes de iniciar o ciclo
+            while (next_event_ < changes_.size() && origin_ + changes_[next_event_].time <= sc_time_stamp()) {
+                const Change& change = changes_[next_event_++];
+                std::cout << "DVFS at " << (sc_time_stamp() - origin_).to_seconds() * 1e9 << " ns: domain " << domain_
+                          << " period " << period_.to_seconds() * 1e9 << " -> "
+                          << change.period.to_seconds() * 1e9 << " ns" << std::endl;
+                period_ = change.period;
+            }
+
+            clk.write(true);
+            cycles_++;
+            sc_time high = period_ / 2;
+            if (!wait_edge(high)) {
+                continue;
+            }
+            clk.write(false);
+            wait_edge(period_ - high);
+        }
+    }
+
+private:
+    struct Change {
+        sc_time time;
+        sc_time period;
+    };
+
+    int domain_;
+    sc_time initial_period_;
+    sc_time period_;
+    sc_time origin_;
+    long long cycles_;
+    std::vector<Change> changes_;
+    size_t next_event_;
+    bool restart_pending_;
+    sc_event restart_event_;
+
+    // Esperar pela próxima borda; um reinício interrompe a espera, baixa o
+    // clock e retoma na origem (retorna false nesse caso)
+    bool wait_edge(const sc_time& delay) {
+        wait(delay, restart_event_);
+        if (!restart_pending_) {
+            return true;
+        }
+        restart_pending_ = false;
+        clk.write(false);
+        wait(origin_ - sc_time_stamp());
+        return false;
+    }
+};
+
+// FIFO de sincronização entre dois domínios de clock
+//
+// Mesma interface de Channel, mas cada lado anda no seu clock: o remetente
+// escreve no clk_in, o destino lê no clk_out. Um pacote escrito só fica
+// visível ao destino após sync_stages bordas do clk_out, e a posição liberada
+// só volta como crédito ao remetente após sync_stages bordas do clk_in, como
+// nos sincronizadores de ponteiros de uma FIFO assíncrona. Há uma fila por
+// classe de mensagem, com créditos próprios. Com largura (bytes por ciclo do
+// clk_in), um pacote ocupa a entrada por ceil(tamanho / largura) ciclos e só
+// entra na FIFO com o último flit, como na serialização do Channel.
+class ClockCrossing : public sc_module {
+public:
+    static const int NUM_CLASSES = Packet::NUM_MESSAGE_CLASSES;
+
+    // Portas do lado do remetente
+    sc_in<bool> clk_in;
+    sc_in<Packet> in_packet;    // Pacote de entrada
+    sc_in<bool> in_valid;       // Sinal de validade da entrada
+    sc_out<int> in_ready;       // Máscara de classes com crédito na entrada
+
+    // Portas do lado do destino
+    sc_in<bool> clk_out;
+    sc_out<Packet> out_packet;  // Pacote de saída
+    sc_out<bool> out_valid;     // Sinal de validade da saída
+    sc_in<int> out_ready;       // Máscara de classes aceitas pelo destino
+
+    // Construtor
+    ClockCrossing(sc_module_name name, int sync_stages = 2, int depth = 6, int width = 0) :
+        sc_module(name),
+        sync_stages(sync_stages < 1 ? 1 : sync_stages),
+        depth(depth < 1 ? 1 : depth),
+        width(width < 0 ? 0 : width),
+        write_cycle(0),
+        read_cycle(0),
+        next_accept_cycle(0),
+        serial_pending(false),
+        serial_done_cycle(0),
+        out_class(-1),
+        next_out_class(0) {
+
+        reset();
+
+        // Registrar processos
+        SC_METHOD(process_write);
+        sensitive << clk_in.pos();
+        dont_initialize();
+
+        SC_METHOD(process_read);
+        sensitive << clk_out.pos();
+        dont_initialize();
+    }
+
+    // Lado do remetente: recolher créditos sincronizados e aceitar pacotes
+    void process_write() {
+        write_cycle++;
+
+        while (!credit_returns.empty() && credit_returns.front().cycle <= write_cycle) {
+            credits[credit_returns.front().message_class]++;
+            credit_returns.pop_front();
+        }
+
+        // Aceitar um pacote se anunciamos crédito para sua classe no ciclo anterior
+        if (in_valid.read()) {
+            Packet packet = in_packet.read();
+            int message_class = packet.getMessageClass();
+            if (in_ready.read() & Packet::classMask(message_class)) {
+                int flits = width > 0 ? (packet.getSizeBytes() + width - 1) / width : 1;
+                serial_packet = packet;
+                serial_pending = true;
+                serial_done_cycle = write_cycle + flits - 1;
+                next_accept_cycle = write_cycle + flits;
+                credits[message_class]--;
+            }
+        }
+
+        // O pacote entra na FIFO quando o último flit chega
+        if (serial_pending && serial_done_cycle <= write_cycle) {
+            fifo[serial_packet.getMessageClass()].push_back(Entry{serial_packet, read_cycle + sync_stages});
+            serial_pending = false;
+        }
+
+        int ready_mask = 0;
+        if (write_cycle + 1 >= next_accept_cycle) {
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                if (credits[c] > 0) {
+                    ready_mask |= Packet::classMask(c);
+                }
+            }
+        }
+        in_ready.write(ready_mask);
+    }
+
+    // Lado do destino: liberar o pacote aceito e apresentar o próximo visível
+    void process_read() {
+        read_cycle++;
+
+        if (out_class >= 0 && (out_ready.read() & Packet::classMask(out_class))) {
+            fifo[out_class].pop_front();
+            credit_returns.push_back(CreditReturn{write_cycle + sync_stages, out_class});
+            out_class = -1;
+        }
+
+        // Preferir classes aceitas pelo destino, em rodízio; o pacote sai da
+        // fila só quando aceito
+        int chosen = -1;
+        for (int k = 0; k < NUM_CLASSES && chosen < 0; k++) {
+            int c = (next_out_class + k) % NUM_CLASSES;
+            if (headVisible(c) && (out_ready.read() & Packet::classMask(c))) {
+                chosen = c;
+            }
+        }
+        if (chosen < 0) {
+            chosen = out_class;
+        }
+        for (int c = 0; c < NUM_CLASSES && chosen < 0; c++) {
+            if (headVisible(c)) {
+                chosen = c;
+            }
+        }
+
+        if (chosen < 0) {
+            out_valid.write(false);
+        } else if (chosen != out_class) {
+            out_packet.write(fifo[chosen].front().packet);
+            out_valid.write(true);
+            out_class = chosen;
+            next_out_class = (chosen + 1) % NUM_CLASSES;
+        }
+    }
+
+    // Esvaziar a FIFO e devolver todos os créditos (reinício da rede)
+    void reset() {
+        write_cycle = 0;
+        read_cycle = 0;
+        next_accept_cycle = 0;
+        serial_pending = false;
+        serial_done_cycle = 0;
+        out_class = -1;
+        next_out_class = 0;
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            credits[c] = depth;
+            fifo[c].clear();
+        }
+        credit_returns.clear();
+    }
+
+    // Pacote da classe já sincronizado e à espera do destino (nullptr se nenhum)
+    const Packet* getHeadPacket(int message_class) const {
+        return headVisible(message_class) ? &fifo[message_class].front().packet : nullptr;
+    }
+
+    // Há pacote ainda sendo serializado ou passando pelos estágios de sincronização
+    bool hasPacketInTransit() const {
+        if (serial_pending) {
+            return true;
+        }
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            for (const Entry& entry : fifo[c]) {
+                if (entry.visible_cycle > read_cycle) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Adicionar à lista os IDs dos pacotes na FIFO e na serialização
+    void collectInFlightIds(std::vector<long long>& ids) const {
+        if (serial_pending) {
+            ids.push_back(serial_packet.getId());
+        }
+        for (int c = 0; c < NUM_CLASSES; c++) {
+            for (const Entry& entry : fifo[c]) {
+                ids.push_back(entry.packet.getId());
+            }
+        }
+    }
+
+private:
+    // Pacote na FIFO e ciclo do destino a partir do qual ele é visível
+    struct Entry {
+        Packet packet;
+        long long visible_cycle;
+    };
+
+    // Crédito sincronizando de volta ao remetente
+    struct CreditReturn {
+        long long cycle;
+        int message_class;
+    };
+
+    int sync_stages;
+    int depth;                            // Posições da FIFO por classe
+    int width;                            // Bytes por ciclo do clk_in (0 = pacote inteiro)
+    int credits[NUM_CLASSES];             // Posições livres vistas pelo remetente, por classe
+    long long write_cycle;                // Bordas do clk_in
+    long long read_cycle;                 // Bordas do clk_out
+    long long next_accept_cycle;          // Entrada ocupada até a serialização terminar
+    Packet serial_packet;                 // Pacote sendo serializado na entrada
+    bool serial_pending;
+    long long serial_done_cycle;          // Ciclo do clk_in do último flit
+    int out_class;                        // Classe apresentada na saída e ainda não aceita (-1 se nenhuma)
+    int next_out_class;                   // Próxima classe no rodízio da saída
+    std::deque<Entry> fifo[NUM_CLASSES];  // Pacotes por classe
+    std::deque<CreditReturn> credit_returns;
+
+    bool headVisible(int message_class) const {
+        return !fifo[message_class].empty() && fifo[message_class].front().visible_cycle <= read_cycle;
+    }
+};
+
+#endif // CLOCK_DOMAINS_H
@@ -0,0 +1,216 @@
+#ifndef DEADLOCK_H
+#define DEADLOCK_H
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "routing_algorithms.h"
+
+// Ferramentas de detecção de deadlock: verificação estática do grafo de
+// dependência de canais (CDG) de um algoritmo de roteamento e busca de ciclos
+// no grafo de espera (wait-for) montado em tempo de execução.
+
+// Identificador de um canal/buffer: router, porta (NORTE, LESTE, SUL, OESTE, LOCAL)
+// e classe de mensagem (rede virtual)
+struct PortId {
+    int router;
+    int port;
+    int message_class;
+};
+
+inline const char* directionName(int port) {
+    static const char* names[] = {"NORTH", "EAST", "SOUTH", "WEST", "LOCAL"};
+    return port >= 0 && port < 5 ? names[port] : "NONE";
+}
+
+// Direção oposta (porta de entrada no vizinho para uma porta de saída)
+inline int oppositeDirection(int port) {
+    switch (port) {
+        case NORTH: return SOUTH;
+        case SOUTH: return NORTH;
+        case EAST: return WEST;
+        case WEST: return EAST;
+        default: return NONE;
+    }
+}
+
+// Router vizinho na direção dada, ou -1 se fora da malha
+inline int neighborRouter(int router, int port, int mesh_size_x, int mesh_size_y) {
+    int x = router % mesh_size_x;
+    int y = router / mesh_size_x;
+    switch (port) {
+        case NORTH: y--; break;
+        case SOUTH: y++; break;
+        case EAST: x++; break;
+        case WEST: x--; break;
+        default: return -1;
+    }
+    if (x < 0 || x >= mesh_size_x || y < 0 || y >= mesh_size_y) {
+        return -1;
+    }
+    return y * mesh_size_x + x;
+}
+
+// Grafo dirigido sobre vértices (router*5 + porta)*classes + classe, com busca de ciclo por DFS
+class PortGraph {
+public:
+    explicit PortGraph(int num_routers, int num_classes = 1) :
+        num_classes_(num_classes),
+        edges_(num_routers * 5 * num_classes) {}
+
+    void addEdge(const PortId& from, const PortId& to) {
+        std::vector<int>& out = edges_[index(from)];
+        int target = index(to);
+        for (int existing : out) {
+            if (existing == target) {
+                return;
+            }
+        }
+        out.push_back(target);
+    }
+
+    // Procurar um ciclo; se encontrado, preenche cycle com os vértices em ordem
+    bool findCycle(std::vector<PortId>& cycle) const {
+        std::vector<int> state(edges_.size(), 0);  // 0 = novo, 1 = na pilha, 2 = concluído
+        std::vector<int> parent(edges_.size(), -1);
+
+        for (size_t start = 0; start < edges_.size(); start++) {
+            if (state[start] != 0 || edges_[start].empty()) {
+                continue;
+            }
+
+            // DFS iterativa: (vértice, próximo índice de aresta)
+            std::vector<std::pair<int, size_t>> stack;
+            stack.push_back(std::make_pair(static_cast<int>(start), 0));
+            state[start] = 1;
+
+            while (!stack.empty()) {
+                int v = stack.back().first;
+                size_t& next = stack.back().second;
+
+                if (next < edges_[v].size()) {
+                    int w = edges_[v][next++];
+                    if (state[w] == 0) {
+                        state[w] = 1;
+                        parent[w] = v;
+                        stack.push_back(std::make_pair(w, 0));
+                    } else if (state[w] == 1) {
+                        // Aresta de retorno: reconstruir o ciclo w -> ... -> v -> w
+                        cycle.clear();
+                        for (int u = v; u != w; u = parent[u]) {
+                            cycle.push_back(portId(u));
+                        }
+                        cycle.push_back(portId(w));
+                        std::vector<PortId> ordered(cycle.rbegin(), cycle.rend());
+                        cycle.swap(ordered);
+                        return true;
+                    }
+                } else {
+                    state[v] = 2;
+                    stack.pop_back();
+                }
+            }
+        }
+        return false;
+    }
+
+    // Descrever um ciclo como "R5.EAST -> R6.SOUTH -> ... -> R5.EAST"; vértices
+    // de classes além da primeira levam o sufixo "/c<classe>"
+    static std::string describe(const std::vector<PortId>& cycle) {
+        std::ostringstream os;
+        for (size_t i = 0; i < cycle.size(); i++) {
+            os << name(cycle[i]) << " -> ";
+        }
+        if (!cycle.empty()) {
+            os << name(cycle[0]);
+        }
+        return os.str();
+    }
+
+    static std::string name(const PortId& id) {
+        std::string text = "R" + std::to_string(id.router) + "." + directionName(id.port);
+        if (id.message_class > 0) {
+            text += "/c" + std::to_string(id.message_class);
+        }
+        return text;
+    }
+
+private:
+    int num_classes_;
+    std::vector<std::vector<int>> edges_;
+
+    int index(const PortId& id) const { return (id.router * 5 + id.port) * num_classes_ + id.message_class; }
+    PortId portId(int index) const {
+        int port_index = index / num_classes_;
+        return PortId{port_index / 5, port_index % 5, index % num_classes_};
+    }
+};
+
+// Verificação estática: montar o CDG seguindo a rota de cada par (origem,
+// destino) e procurar ciclos. Canais são as portas de saída entre routers;
+// todas as classes de mensagem seguem a mesma rota, então basta uma classe.
+// Com usable_routers não vazio, só os routers marcados são origem ou destino
+// (malha com routers desativados). Retorna false e descreve o problema em
+// report se houver ciclo ou rota inválida.
+inline bool checkRoutingDeadlockFreedom(const RoutingAlgorithm& routing,
+                                        int mesh_size_x, int mesh_size_y,
+                                        std::string& report,
+                                        const std::vector<bool>& usable_routers = std::vector<bool>()) {
+    int num_routers = mesh_size_x * mesh_size_y;
+    PortGraph cdg(num_routers);
+
+    for (int src = 0; src < num_routers; src++) {
+        for (int dst = 0; dst < num_routers; dst++) {
+            if (src == dst || (!usable_routers.empty() && (!usable_routers[src] || !usable_routers[dst]))) {
+                continue;
+            }
+
+            int current = src;
+            bool has_previous = false;
+            PortId previous = PortId{0, 0, 0};
+
+            // Uma rota mínima ou não tem no máximo todos os routers da malha
+            for (int hops = 0; current != dst; hops++) {
+                int port = routing.calculateOutputPort(
+                    current % mesh_size_x, current / mesh_size_x,
+                    dst % mesh_size_x, dst / mesh_size_x);
+                int next = neighborRouter(current, port, mesh_size_x, mesh_size_y);
+
+                if (next < 0 || hops > num_routers) {
+                    std::ostringstream os;
+                    os << "rota inválida de " << src << " para " << dst << " em R" << current
+                       << " (porta " << directionName(port) << ")";
+                    report = os.str();
+                    return false;
+                }
+
+                PortId channel = PortId{current, port, 0};
+                if (has_previous) {
+                    cdg.addEdge(previous, channel);
+                }
+                previous = channel;
+                has_previous = true;
+                current = next;
+            }
+        }
+    }
+
+    std::vector<PortId> cycle;
+    if (cdg.findCycle(cycle)) {
+        report = "ciclo no grafo de dependência de canais: " + PortGraph::describe(cycle);
+        return false;
+    }
+
+    report = "grafo de dependência de canais acíclico";
+    return true;
+}
+
+inline bool checkRoutingDeadlockFreedom(const std::string& algorithm_name,
+                                        int mesh_size_x, int mesh_size_y,
+                                        std::string& report) {
+    std::unique_ptr<RoutingAlgorithm> routing(createRoutingAlgorithm(algorithm_name));
+    return checkRoutingDeadlockFreedom(*routing, mesh_size_x, mesh_size_y, report);
+}
+
+#endif // DEADLOCK_H
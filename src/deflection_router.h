@@ -0,0 +1,290 @@
+#ifndef DEFLECTION_ROUTER_H
+#define DEFLECTION_ROUTER_H
+
+#include <systemc.h>
+#include "router.h"
+
+// Router sem buffers com roteamento por desvio (estilo BLESS)
+//
+// Todo pacote que chega sai no ciclo seguinte por alguma porta: os pacotes
+// são atendidos do mais antigo para o mais novo (garante ausência de
+// livelock), cada um pega uma porta produtiva livre, começando pela indicada
+// pelo algoritmo de roteamento, ou é desviado para qualquer porta livre. Como
+// cada entrada de rede corresponde a uma saída de rede, sempre há porta livre.
+// O único armazenamento é um registrador de injeção na porta LOCAL, usado
+// quando sobra uma saída. Os enlaces de rede nunca sofrem contrapressão, então
+// exigem conexão direta (sem Channel).
+class DeflectionRouter : public BaseRouter {
+public:
+    // Construtor
+    DeflectionRouter(sc_module_name name, int x, int y, int mesh_size_x, int mesh_size_y,
+                     RoutingAlgorithm* routing_algorithm) :
+        BaseRouter(name, x, y, mesh_size_x, mesh_size_y, routing_algorithm),
+        injection_pending_(false) {
+
+        // Registrar processos
+        SC_METHOD(process);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    // Processo único: receber, atribuir portas de saída e transmitir
+    void process() {
+        ROUTER_STAT(counters_.cycles++);
+
+        // Router desativado: descartar tudo o que chega e não transmitir nada
+        if (failed_) {
+            process_failed();
+            return;
+        }
+
+        // Pacotes que chegaram pelas portas de rede neste ciclo
+        Arrival arrivals[4];
+        int count = 0;
+        for (int i = 0; i < 4; i++) {
+            if (in_valids[i].read()) {
+                arrivals[count].packet = in_packets[i].read();
+                arrivals[count].input_port = i;
+                arrivals[count].packet.addToPath(getNodeId());
+                arrivals[count].packet.incrementHops();
+                count++;
+            }
+        }
+
+        // Aceitar a injeção do nó se anunciamos o registrador livre
+        if (in_valids[LOCAL].read() && in_readys[LOCAL].read()) {
+            injection_ = in_packets[LOCAL].read();
+            injection_.addToPath(getNodeId());
+            injection_.incrementHops();
+            injection_pending_ = true;
+        }
+        ROUTER_STAT(counters_.ports[LOCAL].occupancy_sum += injection_pending_ ? 1 : 0);
+
+        // Mais antigo primeiro (ordenação por inserção de no máximo 4 índices)
+        int order[4];
+        for (int k = 0; k < count; k++) {
+            int j = k;
+            while (j > 0 && olderThan(arrivals[k].packet, arrivals[order[j - 1]].packet)) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = k;
+        }
+
+        const Packet* assigned[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+        for (int k = 0; k < count; k++) {
+            Arrival& arrival = arrivals[order[k]];
+            if (!isRoutable(arrival.packet)) {
+                // Destino inalcançável após falhas
+                discard(arrival.packet);
+                continue;
+            }
+            bool deflected = false;
+            int output_port = choosePort(arrival.packet, assigned, deflected);
+            if (output_port == NONE) {
+                // Só ocorre quando um enlace falha com um pacote já a caminho:
+                // sem falhas há tantas saídas de rede quanto entradas
+                discard(arrival.packet);
+                continue;
+            }
+            if (deflected) {
+                arrival.packet.incrementDeflections();
+                ROUTER_STAT(counters_.ports[arrival.input_port].arbitration_losses++);
+                trace(TraceEvent::ARBITRATION_LOSS, arrival.packet, arrival.input_port);
+            }
+            assigned[output_port] = &arrival.packet;
+        }
+
+        // Injetar se sobrou alguma saída
+        if (injection_pending_ && !isRoutable(injection_)) {
+            discard(injection_);
+            injection_pending_ = false;
+        }
+        if (injection_pending_) {
+            bool deflected = false;
+            int output_port = choosePort(injection_, assigned, deflected);
+            if (output_port != NONE) {
+                if (deflected) {
+                    injection_.incrementDeflections();
+                    trace(TraceEvent::ARBITRATION_LOSS, injection_, LOCAL);
+                }
+                assigned[output_port] = &injection_;
+                injection_pending_ = false;
+            } else {
+                ROUTER_STAT(counters_.ports[LOCAL].blocked_cycles++);
+            }
+        }
+
+        // Transmitir
+        for (int o = 0; o < 5; o++) {
+            if (assigned[o]) {
+                trace(TraceEvent::HOP, *assigned[o], o);
+                out_packets[o].write(*assigned[o]);
+                out_valids[o].write(true);
+                packets_forwarded_++;
+                ROUTER_STAT(counters_.ports[o].link_busy_cycles += linkCycles(o, *assigned[o]));
+            } else {
+                out_valids[o].write(false);
+            }
+        }
+
+        // Enlaces de rede sempre prontos (exceto os rompidos); a porta LOCAL só
+        // com o registrador livre
+        for (int i = 0; i < 4; i++) {
+            in_readys[i].write(port_failed_[i] ? 0 : Packet::ALL_CLASSES_MASK);
+        }
+        in_readys[LOCAL].write(injection_pending_ ? 0 : Packet::ALL_CLASSES_MASK);
+    }
+
+    void reset() override {
+        BaseRouter::reset();
+        injection_ = Packet();
+        injection_pending_ = false;
+    }
+
+    // O único estado além dos contadores é o registrador de injeção
+    void saveState(CheckpointWriter& out) const override {
+        BaseRouter::saveState(out);
+        out.writeBool(injection_pending_);
+        if (injection_pending_) {
+            injection_.saveState(out);
+        }
+    }
+
+    void loadState(CheckpointReader& in) override {
+        BaseRouter::loadState(in);
+        injection_pending_ = in.readBool();
+        if (injection_pending_) {
+            injection_.loadState(in);
+        }
+    }
+
+    // Sem arbitragem configurável: a prioridade é sempre do mais antigo
+    void setArbiter(Arbiter* arbiter) override { delete arbiter; }
+
+    std::string getArbiterName() const override {
+        return "Oldest First (deflection)";
+    }
+
+    int getBufferOccupancy(int input_port, int message_class) const override {
+        return getHeadPacket(input_port, message_class) ? 1 : 0;
+    }
+
+    const Packet* getHeadPacket(int input_port, int message_class) const override {
+        if (input_port == LOCAL && injection_pending_ && injection_.getMessageClass() == message_class) {
+            return &injection_;
+        }
+        return nullptr;
+    }
+
+    // Pacote no registrador de injeção e pacotes transmitidos ainda não lidos
+    // pelo vizinho (os enlaces não têm outro armazenamento)
+    void collectInFlightIds(std::vector<long long>& ids) const override {
+        if (injection_pending_) {
+            ids.push_back(injection_.getId());
+        }
+        for (int o = 0; o < 5; o++) {
+            if (out_valids[o].read()) {
+                ids.push_back(out_packets[o].read().getId());
+            }
+        }
+    }
+
+private:
+    // Pacote recebido neste ciclo e a porta por onde entrou
+    struct Arrival {
+        Packet packet;
+        int input_port;
+    };
+
+    Packet injection_;         // Registrador de injeção da porta LOCAL
+    bool injection_pending_;   // Registrador ocupado
+
+    // Prioridade por idade: tempo de criação e, no empate, ID de injeção
+    static bool olderThan(const Packet& a, const Packet& b) {
+        if (a.getCreationTime() != b.getCreationTime()) {
+            return a.getCreationTime() < b.getCreationTime();
+        }
+        return a.getId() < b.getId();
+    }
+
+    // Existe vizinho na direção (bordas da malha não têm)
+    bool hasNeighbor(int port) const {
+        switch (port) {
+            case NORTH: return y_ > 0;
+            case SOUTH: return y_ < mesh_size_y_ - 1;
+            case EAST: return x_ < mesh_size_x_ - 1;
+            case WEST: return x_ > 0;
+            default: return false;
+        }
+    }
+
+    bool isFree(int port, const Packet* const assigned[5]) const {
+        return port != NONE && !assigned[port] && (port == LOCAL || (hasNeighbor(port) && !port_failed_[port]));
+    }
+
+    // O algoritmo de roteamento conhece um caminho até o destino
+    bool isRoutable(const Packet& packet) const {
+        return routing_algorithm_->calculateOutputPort(
+            x_, y_, packet.getDstId() % mesh_size_x_, packet.getDstId() / mesh_size_x_) != NONE;
+    }
+
+    // Ciclo de um router desativado: aceitar e descartar as chegadas (vizinhos
+    // transmitem sem esperar pronto) e anunciar todas as entradas prontas
+    void process_failed() {
+        for (int i = 0; i < 4; i++) {
+            if (in_valids[i].read()) {
+                discard(in_packets[i].read());
+            }
+        }
+        if (in_valids[LOCAL].read() && in_readys[LOCAL].read()) {
+            discard(in_packets[LOCAL].read());
+        }
+        if (injection_pending_) {
+            discard(injection_);
+            injection_pending_ = false;
+        }
+        for (int o = 0; o < 5; o++) {
+            out_valids[o].write(false);
+            in_readys[o].write(Packet::ALL_CLASSES_MASK);
+        }
+    }
+
+    // Escolher a saída de um pacote: a porta do algoritmo de roteamento, outra
+    // porta produtiva ou, em último caso, qualquer porta de rede livre (desvio).
+    // Retorna NONE se todas as saídas estão ocupadas.
+    int choosePort(const Packet& packet, const Packet* const assigned[5], bool& deflected) const {
+        int dest_x = packet.getDstId() % mesh_size_x_;
+        int dest_y = packet.getDstId() / mesh_size_x_;
+        deflected = false;
+
+        int preferred = routing_algorithm_->calculateOutputPort(x_, y_, dest_x, dest_y);
+        if (isFree(preferred, assigned)) {
+            return preferred;
+        }
+
+        if (preferred != LOCAL) {
+            int productive[4];
+            int num_productive = 0;
+            if (dest_x > x_) productive[num_productive++] = EAST;
+            if (dest_x < x_) productive[num_productive++] = WEST;
+            if (dest_y > y_) productive[num_productive++] = SOUTH;
+            if (dest_y < y_) productive[num_productive++] = NORTH;
+            for (int k = 0; k < num_productive; k++) {
+                if (isFree(productive[k], assigned)) {
+                    return productive[k];
+                }
+            }
+        }
+
+        deflected = true;
+        for (int port = 0; port < 4; port++) {
+            if (isFree(port, assigned)) {
+                return port;
+            }
+        }
+        return NONE;
+    }
+};
+
+#endif // DEFLECTION_ROUTER_H
@@ -0,0 +1,250 @@
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "checkpoint.h"
+
+// Trace binário de eventos por pacote
+//
+// Cada injeção, passagem por router, perda de arbitragem e entrega vira um
+// registro de poucos bytes: uma etiqueta (tipo e porta), o ciclo e o ID do
+// pacote como diferenças para o registro anterior, o router e a origem e o
+// destino do pacote, tudo em varints (mesma codificação dos checkpoints). Os
+// eventos de um multicast levam uma marca na etiqueta e formam um fluxo
+// próprio (origem -> multicast): o destino gravado é o do ramo, que muda ao
+// longo da árvore, e os filtros de fluxo selecionam só pacotes unicast. O
+// arquivo é gravado em fluxo, sem índice, e lido em ordem pelo
+// tools/trace_reader. Não depende do SystemC: o ciclo vem de um relógio
+// fornecido por quem grava.
+struct TraceEvent {
+    enum Kind { INJECT = 0, HOP = 1, ARBITRATION_LOSS = 2, EJECT = 3 };
+    static const int NUM_KINDS = 4;
+    static const int LOCAL_PORT = 4;   // Mesma numeração de Direction (NORTH=0 ... LOCAL=4)
+    static const int MULTICAST_TAG = 1 << 5;   // Marca de multicast na etiqueta (tipo << 3 | porta)
+
+    // Cabeçalho do arquivo
+    static constexpr const char* FILE_MAGIC = "SimpleNoC trace";
+    static const int FILE_VERSION = 2;
+
+    Kind kind;
+    long long cycle;
+    long long packet_id;
+    int router;
+    int port;      // Porta de saída (HOP), de entrada (ARBITRATION_LOSS) ou LOCAL
+    int src;
+    int dst;
+    bool multicast;   // Evento de um pacote multicast (dst = destino do ramo)
+
+    static const char* kindName(int kind) {
+        static const char* names[NUM_KINDS] = {"inject", "hop", "arbitration_loss", "eject"};
+        return kind >= 0 && kind < NUM_KINDS ? names[kind] : "?";
+    }
+};
+
+// Seleção do que gravar: janelas de ciclos, routers e fluxos origem:destino
+// (listas vazias = tudo)
+class TraceFilter {
+public:
+    TraceFilter(int num_routers = 0) : num_routers_(num_routers) {}
+
+    // Janelas "A:B,C:D" de ciclos, inclusive
+    bool parseWindows(const std::string& text) {
+        windows_.clear();
+        std::vector<std::pair<long long, long long>> pairs;
+        if (!parsePairs(text, pairs)) {
+            return false;
+        }
+        for (const auto& window : pairs) {
+            if (window.first < 0 || window.second < window.first) {
+                return false;
+            }
+        }
+        windows_ = pairs;
+        return true;
+    }
+
+    // Routers "0,5,10"
+    bool parseRouters(const std::string& text) {
+        routers_.assign(num_routers_, false);
+        std::istringstream in(text);
+        std::string item;
+        bool any = false;
+        while (std::getline(in, item, ',')) {
+            std::istringstream field(item);
+            int router;
+            if (!(field >> router) || router < 0 || router >= num_routers_) {
+                return false;
+            }
+            routers_[router] = true;
+            any = true;
+        }
+        return any;
+    }
+
+    // Fluxos "origem:destino,..." (todos os pacotes unicast de origem para destino)
+    bool parseFlows(const std::string& text) {
+        flows_.assign(static_cast<size_t>(num_routers_) * num_routers_, false);
+        std::vector<std::pair<long long, long long>> pairs;
+        if (!parsePairs(text, pairs)) {
+            return false;
+        }
+        for (const auto& flow : pairs) {
+            if (flow.first < 0 || flow.first >= num_routers_ || flow.second < 0 || flow.second >= num_routers_) {
+                return false;
+            }
+            flows_[flow.first * num_routers_ + flow.second] = true;
+        }
+        return true;
+    }
+
+    bool inWindow(long long cycle) const {
+        if (windows_.empty()) {
+            return true;
+        }
+        for (const auto& window : windows_) {
+            if (cycle >= window.first && cycle <= window.second) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool accepts(int router, int src, int dst, bool multicast) const {
+        return (routers_.empty() || routers_[router]) &&
+               (flows_.empty() || (!multicast && flows_[static_cast<size_t>(src) * num_routers_ + dst]));
+    }
+
+private:
+    int num_routers_;
+    std::vector<std::pair<long long, long long>> windows_;
+    std::vector<bool> routers_;
+    std::vector<bool> flows_;
+
+    static bool parsePairs(const std::string& text, std::vector<std::pair<long long, long long>>& pairs) {
+        std::istringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            std::istringstream field(item);
+            long long first, second;
+            char separator;
+            if (!(field >> first >> separator >> second) || separator != ':') {
+                return false;
+            }
+            pairs.push_back(std::make_pair(first, second));
+        }
+        return !pairs.empty();
+    }
+};
+
+// Gravação em fluxo dos eventos aceitos pelo filtro
+class EventTraceWriter {
+public:
+    EventTraceWriter(const std::string& filename, int mesh_size_x, int mesh_size_y,
+                     const TraceFilter& filter, std::function<long long()> clock) :
+        file_(filename, std::ios::binary),
+        out_(file_),
+        filter_(filter),
+        clock_(std::move(clock)),
+        last_cycle_(0),
+        last_id_(0),
+        events_(0) {
+        out_.writeString(TraceEvent::FILE_MAGIC);
+        out_.writeInt(TraceEvent::FILE_VERSION);
+        out_.writeInt(mesh_size_x);
+        out_.writeInt(mesh_size_y);
+    }
+
+    bool ok() const { return static_cast<bool>(file_) && out_.ok(); }
+
+    void record(TraceEvent::Kind kind, long long packet_id, int router, int port, int src, int dst, bool multicast) {
+        long long cycle = clock_();
+        if (!filter_.inWindow(cycle) || !filter_.accepts(router, src, dst, multicast)) {
+            return;
+        }
+        // Processos de um mesmo ciclo gravam em qualquer ordem, mas o ciclo
+        // nunca volta: a diferença é sempre não negativa
+        out_.writeUnsigned(static_cast<uint64_t>((multicast ? TraceEvent::MULTICAST_TAG : 0) | (kind << 3) | (port & 7)));
+        out_.writeUnsigned(static_cast<uint64_t>(cycle - last_cycle_));
+        out_.writeInt(packet_id - last_id_);
+        out_.writeUnsigned(static_cast<uint64_t>(router));
+        out_.writeUnsigned(static_cast<uint64_t>(src));
+        out_.writeUnsigned(static_cast<uint64_t>(dst));
+        last_cycle_ = cycle;
+        last_id_ = packet_id;
+        events_++;
+    }
+
+    long long getEvents() const { return events_; }
+    long long getBytes() { return static_cast<long long>(file_.tellp()); }
+
+    void close() { file_.close(); }
+
+private:
+    std::ofstream file_;
+    CheckpointWriter out_;
+    TraceFilter filter_;
+    std::function<long long()> clock_;
+    long long last_cycle_;
+    long long last_id_;
+    long long events_;
+};
+
+// Leitura sequencial de um trace
+class EventTraceReader {
+public:
+    explicit EventTraceReader(std::istream& in) :
+        in_(in),
+        reader_(in),
+        mesh_size_x_(0),
+        mesh_size_y_(0),
+        last_cycle_(0),
+        last_id_(0) {}
+
+    // Conferir o cabeçalho; false se não for um trace desta versão
+    bool readHeader() {
+        if (reader_.readString() != TraceEvent::FILE_MAGIC || reader_.readInt() != TraceEvent::FILE_VERSION) {
+            return false;
+        }
+        mesh_size_x_ = static_cast<int>(reader_.readInt());
+        mesh_size_y_ = static_cast<int>(reader_.readInt());
+        return reader_.ok() && mesh_size_x_ > 0 && mesh_size_y_ > 0;
+    }
+
+    // Próximo evento; false no fim do arquivo ou em registro truncado (ver ok())
+    bool next(TraceEvent& event) {
+        if (in_.peek() == std::char_traits<char>::eof()) {
+            return false;
+        }
+        int tag = static_cast<int>(reader_.readUnsigned());
+        event.kind = static_cast<TraceEvent::Kind>((tag >> 3) & 3);
+        event.port = tag & 7;
+        event.multicast = (tag & TraceEvent::MULTICAST_TAG) != 0;
+        last_cycle_ += static_cast<long long>(reader_.readUnsigned());
+        last_id_ += reader_.readInt();
+        event.cycle = last_cycle_;
+        event.packet_id = last_id_;
+        event.router = static_cast<int>(reader_.readUnsigned());
+        event.src = static_cast<int>(reader_.readUnsigned());
+        event.dst = static_cast<int>(reader_.readUnsigned());
+        return reader_.ok();
+    }
+
+    bool ok() const { return reader_.ok(); }
+    int getMeshSizeX() const { return mesh_size_x_; }
+    int getMeshSizeY() const { return mesh_size_y_; }
+
+private:
+    std::istream& in_;
+    CheckpointReader reader_;
+    int mesh_size_x_, mesh_size_y_;
+    long long last_cycle_;
+    long long last_id_;
+};
+
+#endif // EVENT_TRACE_H
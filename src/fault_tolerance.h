@@ -0,0 +1,348 @@
+#ifndef FAULT_TOLERANCE_H
+#define FAULT_TOLERANCE_H
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "routing_algorithms.h"
+#include "deadlock.h"
+
+// Falha de um enlace (entre os routers a e b) ou de um router inteiro (a),
+// aplicada no ciclo indicado (0 = desde o início, como em dies com tiles desativados)
+struct FaultEvent {
+    enum Kind {
+        LINK,
+        ROUTER
+    };
+
+    Kind kind;
+    int a;
+    int b;
+    int cycle;
+
+    std::string describe() const {
+        if (kind == LINK) {
+            return "link " + std::to_string(a) + "-" + std::to_string(b);
+        }
+        return "router " + std::to_string(a);
+    }
+};
+
+// Lista de falhas a injetar, em ordem de ciclo
+class FaultSchedule {
+public:
+    void add(const FaultEvent& event) {
+        events_.push_back(event);
+        std::stable_sort(events_.begin(), events_.end(), [](const FaultEvent& x, const FaultEvent& y) {
+            return x.cycle < y.cycle;
+        });
+    }
+
+    const std::vector<FaultEvent>& getEvents() const { return events_; }
+    bool empty() const { return events_.empty(); }
+
+    // Carregar falhas de um arquivo com linhas "link a b [ciclo]" (routers
+    // vizinhos) ou "router r [ciclo]"; linhas vazias e iniciadas por '#' são ignoradas
+    bool loadFromFile(const std::string& filename, int mesh_size_x, int mesh_size_y, std::string& error) {
+        int num_routers = mesh_size_x * mesh_size_y;
+        std::ifstream in(filename);
+        if (!in) {
+            error = "não foi possível abrir " + filename;
+            return false;
+        }
+
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line)) {
+            line_number++;
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            std::istringstream fields(line);
+            std::string kind;
+            FaultEvent event;
+            event.b = -1;
+            event.cycle = 0;
+            fields >> kind;
+            bool valid;
+            if (kind == "link") {
+                event.kind = FaultEvent::LINK;
+                valid = static_cast<bool>(fields >> event.a >> event.b);
+            } else if (kind == "router") {
+                event.kind = FaultEvent::ROUTER;
+                valid = static_cast<bool>(fields >> event.a);
+            } else {
+                valid = false;
+            }
+            if (!valid) {
+                error = filename + ":" + std::to_string(line_number) + ": linha inválida";
+                return false;
+            }
+            fields >> event.cycle;
+
+            if (event.a < 0 || event.a >= num_routers || event.cycle < 0 ||
+                (event.kind == FaultEvent::LINK && (event.b < 0 || event.b >= num_routers))) {
+                error = filename + ":" + std::to_string(line_number) + ": valores fora do intervalo";
+                return false;
+            }
+            if (event.kind == FaultEvent::LINK && linkPort(event.a, event.b, mesh_size_x, mesh_size_y) == NONE) {
+                error = filename + ":" + std::to_string(line_number) + ": routers " + std::to_string(event.a) +
+                        " e " + std::to_string(event.b) + " não são vizinhos";
+                return false;
+            }
+            add(event);
+        }
+        return true;
+    }
+
+    // Porta do router a que leva ao vizinho b (NONE se não forem vizinhos)
+    static int linkPort(int a, int b, int mesh_size_x, int mesh_size_y) {
+        for (int port = 0; port < 4; port++) {
+            if (neighborRouter(a, port, mesh_size_x, mesh_size_y) == b) {
+                return port;
+            }
+        }
+        return NONE;
+    }
+
+private:
+    std::vector<FaultEvent> events_;
+};
+
+// Estado das falhas da malha: routers desativados e enlaces rompidos
+class MeshFaults {
+public:
+    MeshFaults(int mesh_size_x = 0, int mesh_size_y = 0) :
+        mesh_size_x_(mesh_size_x),
+        mesh_size_y_(mesh_size_y),
+        router_alive_(mesh_size_x * mesh_size_y, true),
+        failed_routers_(0) {}
+
+    int getMeshSizeX() const { return mesh_size_x_; }
+    int getMeshSizeY() const { return mesh_size_y_; }
+    int getNumRouters() const { return mesh_size_x_ * mesh_size_y_; }
+
+    // Aplicar uma falha; retorna false se ela já estava aplicada
+    bool apply(const FaultEvent& event) {
+        if (event.kind == FaultEvent::ROUTER) {
+            if (!router_alive_[event.a]) {
+                return false;
+            }
+            router_alive_[event.a] = false;
+            failed_routers_++;
+            return true;
+        }
+        return failed_links_.insert(key(event.a, event.b)).second;
+    }
+
+    bool isRouterAlive(int router) const { return router_alive_[router]; }
+    const std::vector<bool>& getAliveRouters() const { return router_alive_; }
+
+    // Enlace utilizável: ambos os routers vivos e o enlace não rompido
+    bool isLinkAlive(int a, int b) const {
+        return router_alive_[a] && router_alive_[b] && failed_links_.count(key(a, b)) == 0;
+    }
+
+    int getNumFailedLinks() const { return static_cast<int>(failed_links_.size()); }
+    int getNumFailedRouters() const { return failed_routers_; }
+    bool any() const { return failed_routers_ > 0 || !failed_links_.empty(); }
+
+private:
+    int mesh_size_x_, mesh_size_y_;
+    std::vector<bool> router_alive_;
+    std::set<std::pair<int, int>> failed_links_;  // Pares (menor, maior)
+    int failed_routers_;
+
+    static std::pair<int, int> key(int a, int b) {
+        return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+    }
+};
+
+// Tabelas de roteamento up*/down* sobre os componentes sem falha
+//
+// Uma árvore BFS a partir de uma raiz próxima ao centro define a direção de
+// cada enlace: "up" aponta para o router de menor (nível, ID). Uma rota legal
+// usa zero ou mais enlaces up seguidos de zero ou mais enlaces down, o que
+// proíbe a curva down->up e torna o grafo de dependência de canais acíclico.
+// Cada router desce direto quando o destino é alcançável só por enlaces down
+// e, senão, sobe pelo vizinho com menor distância legal até o destino; assim
+// a tabela depende apenas de (router, destino) e toda rota permanece legal.
+class UpDownRoutingTable {
+public:
+    UpDownRoutingTable() : mesh_size_x_(0), num_routers_(0), root_(-1) {}
+
+    // Recalcular as tabelas para o estado de falhas atual
+    void rebuild(const MeshFaults& faults) {
+        mesh_size_x_ = faults.getMeshSizeX();
+        int mesh_size_y = faults.getMeshSizeY();
+        num_routers_ = faults.getNumRouters();
+        next_port_.assign(static_cast<size_t>(num_routers_) * num_routers_, static_cast<signed char>(NONE));
+
+        // Vizinhos utilizáveis de cada router
+        std::vector<std::vector<std::pair<int, int>>> links(num_routers_);  // (porta, vizinho)
+        for (int r = 0; r < num_routers_; r++) {
+            for (int port = 0; port < 4; port++) {
+                int neighbor = neighborRouter(r, port, mesh_size_x_, mesh_size_y);
+                if (neighbor >= 0 && faults.isLinkAlive(r, neighbor)) {
+                    links[r].push_back(std::make_pair(port, neighbor));
+                }
+            }
+        }
+
+        // Raiz: router vivo mais próximo do centro da malha
+        root_ = -1;
+        int best_distance = INT_MAX;
+        for (int r = 0; r < num_routers_; r++) {
+            int distance = std::abs(2 * (r % mesh_size_x_) - (mesh_size_x_ - 1)) +
+                           std::abs(2 * (r / mesh_size_x_) - (mesh_size_y - 1));
+            if (faults.isRouterAlive(r) && distance < best_distance) {
+                root_ = r;
+                best_distance = distance;
+            }
+        }
+        if (root_ < 0) {
+            return;
+        }
+
+        // Níveis da árvore BFS (-1 = fora da componente da raiz)
+        level_.assign(num_routers_, -1);
+        std::vector<int> order;
+        order.push_back(root_);
+        level_[root_] = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            int r = order[i];
+            for (const auto& link : links[r]) {
+                if (level_[link.second] < 0) {
+                    level_[link.second] = level_[r] + 1;
+                    order.push_back(link.second);
+                }
+            }
+        }
+
+        // Ordem crescente de (nível, ID): enlaces up apontam para trás nesta ordem
+        std::sort(order.begin(), order.end(), [this](int a, int b) { return isAbove(a, b); });
+
+        const int UNREACHABLE = INT_MAX / 2;
+        std::vector<int> down_distance(num_routers_);
+        std::vector<int> legal_distance(num_routers_);
+        for (int dst : order) {
+            // Distância só por enlaces down: BFS reversa a partir do destino
+            std::fill(down_distance.begin(), down_distance.end(), UNREACHABLE);
+            down_distance[dst] = 0;
+            std::vector<int> queue(1, dst);
+            for (size_t i = 0; i < queue.size(); i++) {
+                int r = queue[i];
+                for (const auto& link : links[r]) {
+                    int upper = link.second;
+                    if (isAbove(upper, r) && down_distance[upper] == UNREACHABLE) {
+                        down_distance[upper] = down_distance[r] + 1;
+                        queue.push_back(upper);
+                    }
+                }
+            }
+
+            // Distância legal (up* down*): vizinhos up já foram calculados
+            for (int r : order) {
+                legal_distance[r] = down_distance[r];
+                for (const auto& link : links[r]) {
+                    if (isAbove(link.second, r)) {
+                        legal_distance[r] = std::min(legal_distance[r], legal_distance[link.second] + 1);
+                    }
+                }
+            }
+
+            for (int r : order) {
+                entry(r, dst) = static_cast<signed char>(selectPort(r, dst, links[r], down_distance, legal_distance));
+            }
+        }
+    }
+
+    // Porta de saída no router para o destino (NONE se inalcançável)
+    Direction lookup(int router, int dst) const {
+        if (router < 0 || router >= num_routers_ || dst < 0 || dst >= num_routers_) {
+            return NONE;
+        }
+        return static_cast<Direction>(next_port_[static_cast<size_t>(router) * num_routers_ + dst]);
+    }
+
+    int getRoot() const { return root_; }
+
+    // Router na mesma componente conexa da raiz (alcançável pelos demais)
+    bool isReachable(int router) const {
+        return root_ >= 0 && level_[router] >= 0;
+    }
+
+private:
+    int mesh_size_x_;
+    int num_routers_;
+    int root_;
+    std::vector<int> level_;               // Nível BFS de cada router (-1 = desconectado)
+    std::vector<signed char> next_port_;   // Porta de saída por (router, destino)
+
+    // a está acima de b na orientação up*/down*
+    bool isAbove(int a, int b) const {
+        return level_[a] < level_[b] || (level_[a] == level_[b] && a < b);
+    }
+
+    signed char& entry(int router, int dst) {
+        return next_port_[static_cast<size_t>(router) * num_routers_ + dst];
+    }
+
+    int selectPort(int r, int dst, const std::vector<std::pair<int, int>>& links,
+                   const std::vector<int>& down_distance, const std::vector<int>& legal_distance) const {
+        if (r == dst) {
+            return LOCAL;
+        }
+
+        // Descer se o destino é alcançável só por enlaces down
+        for (const auto& link : links) {
+            if (isAbove(r, link.second) && down_distance[link.second] + 1 == down_distance[r]) {
+                return link.first;
+            }
+        }
+
+        // Senão subir pelo vizinho com menor distância legal
+        int best_port = NONE;
+        int best = legal_distance[r];
+        for (const auto& link : links) {
+            if (isAbove(link.second, r) && legal_distance[link.second] < best) {
+                best_port = link.first;
+                best = legal_distance[link.second];
+            }
+        }
+        return best_port;
+    }
+};
+
+// Algoritmo de roteamento tolerante a falhas: consulta tabelas up*/down*
+// compartilhadas por todos os routers e recalculadas a cada falha
+class UpDownRoutingAlgorithm : public RoutingAlgorithm {
+public:
+    UpDownRoutingAlgorithm(std::shared_ptr<const UpDownRoutingTable> table, int mesh_size_x) :
+        table_(table),
+        mesh_size_x_(mesh_size_x) {}
+
+    Direction calculateOutputPort(
+        int current_x, int current_y,
+        int dest_x, int dest_y) const override {
+        return table_->lookup(current_y * mesh_size_x_ + current_x, dest_y * mesh_size_x_ + dest_x);
+    }
+
+    std::string getName() const override {
+        return "Up*/Down* Routing";
+    }
+
+private:
+    std::shared_ptr<const UpDownRoutingTable> table_;
+    int mesh_size_x_;
+};
+
+#endif // FAULT_TOLERANCE_H
@@ -0,0 +1,88 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "checkpoint.h"
+
+// Histograma de latências em ciclos, com um contador por valor: percentis
+// exatos com memória proporcional à maior latência observada
+class LatencyHistogram {
+public:
+    LatencyHistogram() : count_(0), sum_(0) {}
+
+    void add(int latency) {
+        if (latency < 0) {
+            latency = 0;
+        }
+        if (static_cast<size_t>(latency) >= bins_.size()) {
+            bins_.resize(static_cast<size_t>(latency) + 1, 0);
+        }
+        bins_[latency]++;
+        count_++;
+        sum_ += latency;
+    }
+
+    void merge(const LatencyHistogram& other) {
+        if (other.bins_.size() > bins_.size()) {
+            bins_.resize(other.bins_.size(), 0);
+        }
+        for (size_t i = 0; i < other.bins_.size(); i++) {
+            bins_[i] += other.bins_[i];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+    }
+
+    uint64_t getCount() const { return count_; }
+    int getMax() const { return bins_.empty() ? 0 : static_cast<int>(bins_.size()) - 1; }
+
+    // Amostras com exatamente esta latência
+    uint64_t getBin(int latency) const {
+        return latency >= 0 && static_cast<size_t>(latency) < bins_.size() ? bins_[latency] : 0;
+    }
+
+    double getMean() const {
+        return count_ > 0 ? static_cast<double>(sum_) / count_ : 0.0;
+    }
+
+    // Menor latência L tal que pelo menos percent% das amostras são <= L
+    int getPercentile(double percent) const {
+        if (count_ == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(std::ceil(percent / 100.0 * count_));
+        if (target < 1) {
+            target = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < bins_.size(); i++) {
+            seen += bins_[i];
+            if (seen >= target) {
+                return static_cast<int>(i);
+            }
+        }
+        return getMax();
+    }
+
+    // Gravar e restaurar as contagens; total e soma derivam delas (checkpoint)
+    void saveState(CheckpointWriter& out) const { out.writeUnsigneds(bins_); }
+
+    void loadState(CheckpointReader& in) {
+        bins_ = in.readUnsigneds();
+        count_ = 0;
+        sum_ = 0;
+        for (size_t i = 0; i < bins_.size(); i++) {
+            count_ += bins_[i];
+            sum_ += bins_[i] * i;
+        }
+    }
+
+private:
+    std::vector<uint64_t> bins_;  // Amostras por valor de latência
+    uint64_t count_;
+    uint64_t sum_;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,351 @@
+#ifndef LIVE_METRICS_H
+#define LIVE_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Métricas ao vivo de uma simulação em andamento
+//
+// O simulador publica periodicamente um retrato de tamanho fixo (ciclo,
+// ciclos simulados por segundo, pacotes em trânsito, histograma acumulado
+// de latências e ocupação dos buffers de cada router) em um segmento de
+// memória compartilhada com nome, lido por tools/live_monitor. A publicação
+// nunca espera pelo leitor: um contador de sequência ímpar durante a cópia
+// (seqlock) faz o leitor repetir a leitura que pegou uma publicação pela
+// metade. Não depende do SystemC.
+struct LiveMetricsSnapshot {
+    static constexpr uint32_t MAGIC = 0x4c434f4e;   // "NOCL"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr int LATENCY_BINS = 512;       // Latências de 0 a 511 ciclos, uma por posição
+    static constexpr int MAX_ROUTERS = 256;        // Malha 16x16
+
+    enum State { RUNNING = 0, RUN_FINISHED = 1, ABORTED = 2 };
+
+    uint32_t magic;
+    uint32_t version;
+    int64_t pid;               // Processo do simulador
+    int32_t mesh_size_x;
+    int32_t mesh_size_y;
+    int32_t run;               // Execução atual (1, 2, ... com -runs)
+    int32_t state;
+    int32_t closed;            // Simulador encerrado: nenhuma publicação virá depois desta
+    int32_t size;              // sizeof(LiveMetricsSnapshot) de quem publicou
+    int64_t cycle;             // Último ciclo simulado
+    int64_t last_cycle;        // Fim da execução (geração de pacotes e escoamento)
+    int64_t generation_end;    // Último ciclo de geração de pacotes
+    double offered_load;       // Pacotes/ciclo oferecidos pelos nós ativos (0 = desconhecida)
+    int64_t updated_ms;        // Relógio do sistema na publicação (ms desde 1970)
+    double wall_seconds;       // Tempo real desde o início da execução
+    double cycles_per_second;  // Ciclos simulados por segundo desde a publicação anterior
+    int64_t sent;
+    int64_t received;
+    int64_t in_flight;         // Injetados no scoreboard ainda não entregues nem perdidos
+    int64_t lost;
+    uint64_t latency_count;
+    uint64_t latency_sum;
+    int64_t latency_max;
+    uint64_t latency_overflow;  // Amostras com latência >= LATENCY_BINS
+    uint64_t latency_bins[LATENCY_BINS];
+    int32_t occupancy[MAX_ROUTERS];  // Pacotes nos buffers de entrada de cada router
+
+    LiveMetricsSnapshot() { std::memset(this, 0, sizeof(*this)); }
+
+    int numRouters() const { return mesh_size_x * mesh_size_y; }
+
+    double latencyMean() const {
+        return latency_count > 0 ? static_cast<double>(latency_sum) / latency_count : 0.0;
+    }
+
+    // Menor latência L com pelo menos percent% das amostras <= L; -1 se o
+    // percentil cai acima do histograma (>= LATENCY_BINS)
+    int latencyPercentile(double percent) const {
+        if (latency_count == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(percent / 100.0 * latency_count + 0.999999);
+        if (target < 1) {
+            target = 1;
+        }
+        uint64_t seen = 0;
+        for (int i = 0; i < LATENCY_BINS; i++) {
+            seen += latency_bins[i];
+            if (seen >= target) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    static const char* stateName(int state) {
+        static const char* names[3] = {"running", "run finished", "aborted"};
+        return state >= 0 && state < 3 ? names[state] : "?";
+    }
+};
+
+// Layout do segmento compartilhado
+struct LiveMetricsSegment {
+    std::atomic<uint64_t> sequence;   // Ímpar durante uma publicação
+    LiveMetricsSnapshot snapshot;
+};
+
+// Mapeamento de um segmento com nome: POSIX shm_open/mmap ("/simplenoc_NOME")
+// ou CreateFileMapping no Windows ("Local\simplenoc_NOME")
+class LiveMetricsMapping {
+public:
+    LiveMetricsMapping() : segment_(nullptr), owner_(false) {
+#ifdef _WIN32
+        handle_ = nullptr;
+#endif
+    }
+
+    ~LiveMetricsMapping() { unmap(); }
+
+    LiveMetricsMapping(const LiveMetricsMapping&) = delete;
+    LiveMetricsMapping& operator=(const LiveMetricsMapping&) = delete;
+
+    // Nomes aceitos: letras, dígitos, '_' e '-', até 64 caracteres
+    static bool isValidName(const std::string& name) {
+        if (name.empty() || name.size() > 64) {
+            return false;
+        }
+        for (char c : name) {
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-')) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Criar (ou reaproveitar, após um simulador interrompido) o segmento NOME
+    bool create(const std::string& name, std::string& error) { return map(name, true, error); }
+
+    // Abrir o segmento de um simulador em execução
+    bool open(const std::string& name, std::string& error) { return map(name, false, error); }
+
+    LiveMetricsSegment* get() const { return segment_; }
+
+    // Desfazer o mapeamento; quem criou remove o nome (leitores já conectados
+    // continuam vendo a última publicação)
+    void unmap() {
+        if (!segment_) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(segment_);
+        CloseHandle(handle_);
+        handle_ = nullptr;
+#else
+        munmap(segment_, sizeof(LiveMetricsSegment));
+        if (owner_) {
+            shm_unlink(path_.c_str());
+        }
+#endif
+        segment_ = nullptr;
+    }
+
+private:
+    LiveMetricsSegment* segment_;
+    bool owner_;
+    std::string path_;
+#ifdef _WIN32
+    HANDLE handle_;
+#endif
+
+    bool map(const std::string& name, bool create, std::string& error) {
+        unmap();
+        if (!isValidName(name)) {
+            error = "nome inválido \"" + name + "\" (letras, dígitos, '_' e '-', até 64 caracteres)";
+            return false;
+        }
+        void* address = nullptr;
+#ifdef _WIN32
+        path_ = "Local\\simplenoc_" + name;
+        if (create) {
+            handle_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                         static_cast<DWORD>(sizeof(LiveMetricsSegment)), path_.c_str());
+        } else {
+            handle_ = OpenFileMappingA(FILE_MAP_READ, FALSE, path_.c_str());
+        }
+        if (!handle_) {
+            error = "não foi possível " + std::string(create ? "criar" : "abrir") + " o segmento " + path_;
+            return false;
+        }
+        address = MapViewOfFile(handle_, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, sizeof(LiveMetricsSegment));
+        if (!address) {
+            CloseHandle(handle_);
+            handle_ = nullptr;
+            error = "não foi possível mapear o segmento " + path_;
+            return false;
+        }
+#else
+        path_ = "/simplenoc_" + name;
+        int fd = create ? shm_open(path_.c_str(), O_CREAT | O_RDWR, 0644) : shm_open(path_.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            error = "não foi possível " + std::string(create ? "criar" : "abrir") + " o segmento " + path_;
+            return false;
+        }
+        struct stat info;
+        bool sized = create ? ftruncate(fd, sizeof(LiveMetricsSegment)) == 0
+                            : fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(LiveMetricsSegment));
+        if (sized) {
+            address = mmap(nullptr, sizeof(LiveMetricsSegment), create ? PROT_READ | PROT_WRITE : PROT_READ,
+                           MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (!sized || address == MAP_FAILED) {
+            error = "não foi possível mapear o segmento " + path_;
+            return false;
+        }
+#endif
+        segment_ = static_cast<LiveMetricsSegment*>(address);
+        owner_ = create;
+        return true;
+    }
+};
+
+// Lado do simulador: publica retratos no segmento e mede a velocidade
+class LiveMetricsPublisher {
+public:
+    LiveMetricsPublisher() : run_(0), start_cycle_(0), last_cycle_(0) {}
+
+    ~LiveMetricsPublisher() { close(); }
+
+    bool open(const std::string& name, std::string& error) {
+        if (!mapping_.create(name, error)) {
+            return false;
+        }
+        name_ = name;
+        return true;
+    }
+
+    const std::string& getName() const { return name_; }
+
+    // Início de uma execução: zera a medição de tempo real
+    void beginRun(long long start_cycle) {
+        run_++;
+        run_start_ = std::chrono::steady_clock::now();
+        last_publish_ = run_start_;
+        start_cycle_ = start_cycle;
+        last_cycle_ = start_cycle;
+    }
+
+    // Retrato zerado a preencher pelo simulador antes de publish() (fora da
+    // pilha dos processos SystemC)
+    LiveMetricsSnapshot& next() {
+        snapshot_ = LiveMetricsSnapshot();
+        return snapshot_;
+    }
+
+    // Publicar o retrato de next(); completa processo, execução, tempos e
+    // velocidade. Não bloqueia.
+    void publish() {
+        LiveMetricsSnapshot& snapshot = snapshot_;
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - last_publish_).count();
+        snapshot.magic = LiveMetricsSnapshot::MAGIC;
+        snapshot.version = LiveMetricsSnapshot::VERSION;
+        snapshot.size = static_cast<int32_t>(sizeof(LiveMetricsSnapshot));
+        snapshot.pid = currentProcessId();
+        snapshot.run = run_;
+        snapshot.wall_seconds = std::chrono::duration<double>(now - run_start_).count();
+        // Ao final da execução, a média da execução inteira
+        if (snapshot.state != LiveMetricsSnapshot::RUNNING) {
+            elapsed = snapshot.wall_seconds;
+            last_cycle_ = start_cycle_;
+        }
+        snapshot.cycles_per_second = elapsed > 0 ? (snapshot.cycle - last_cycle_) / elapsed : 0.0;
+        snapshot.updated_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        last_publish_ = now;
+        last_cycle_ = snapshot.cycle;
+        write(snapshot);
+    }
+
+    // Marcar o último retrato como final e remover o nome do segmento
+    void close() {
+        LiveMetricsSegment* segment = mapping_.get();
+        if (!segment) {
+            return;
+        }
+        if (snapshot_.magic == LiveMetricsSnapshot::MAGIC) {
+            snapshot_.closed = 1;
+            write(snapshot_);
+        }
+        mapping_.unmap();
+    }
+
+private:
+    LiveMetricsMapping mapping_;
+    std::string name_;
+    int run_;
+    long long start_cycle_;
+    long long last_cycle_;
+    std::chrono::steady_clock::time_point run_start_;
+    std::chrono::steady_clock::time_point last_publish_;
+    LiveMetricsSnapshot snapshot_;   // Último retrato publicado
+
+    void write(const LiveMetricsSnapshot& snapshot) {
+        LiveMetricsSegment* segment = mapping_.get();
+        uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+        segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&segment->snapshot), &snapshot, sizeof(snapshot));
+        segment->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    static int64_t currentProcessId() {
+#ifdef _WIN32
+        return static_cast<int64_t>(GetCurrentProcessId());
+#else
+        return static_cast<int64_t>(getpid());
+#endif
+    }
+};
+
+// Lado do monitor: lê o retrato mais recente sem interferir no simulador
+class LiveMetricsReader {
+public:
+    bool open(const std::string& name, std::string& error) { return mapping_.open(name, error); }
+
+    // Copiar um retrato consistente; false se ainda não houve publicação ou
+    // o segmento é de outra versão
+    bool read(LiveMetricsSnapshot& snapshot) const {
+        const LiveMetricsSegment* segment = mapping_.get();
+        for (int attempt = 0; attempt < 1000; attempt++) {
+            uint64_t before = segment->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            std::memcpy(static_cast<void*>(&snapshot), &segment->snapshot, sizeof(snapshot));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (segment->sequence.load(std::memory_order_relaxed) == before) {
+                return snapshot.magic == LiveMetricsSnapshot::MAGIC && snapshot.version == LiveMetricsSnapshot::VERSION &&
+                       snapshot.size == static_cast<int32_t>(sizeof(LiveMetricsSnapshot));
+            }
+        }
+        return false;
+    }
+
+private:
+    LiveMetricsMapping mapping_;
+};
+
+#endif // LIVE_METRICS_H
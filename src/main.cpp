@@ -3,78 +3,846 @@
 #include <string>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
+#include <sstream>
+#include <vector>
 #include "noc.h"
 #include "routing_algorithms.h"
+#include "deadlock.h"
+#include "arbitration.h"
+#include "fault_tolerance.h"
+#include "clock_domains.h"
+#include "event_trace.h"
+#include "results_store.h"
+#include "live_metrics.h"
+#include "analytical_model.h"
 
-// Função para executar uma simulação com parâmetros especificados
-void run_simulation(int mesh_size, const std::string& routing_algorithm, 
-                   int packet_injection_rate, int simulation_time) {
-    // Criar NoC
-    NoC noc("network_on_chip", mesh_size, mesh_size, 
-            routing_algorithm, packet_injection_rate, simulation_time);
-    
-    // Iniciar simulação e aguardar completar
-    sc_start();
-}
-
-int main(int argc, char* argv[]) {
-    // Inicializar gerador de números aleatórios
-    std::srand(std::time(nullptr));
-    
-    // Parâmetros padrão
+// Configuração de uma execução, lida da linha de comando (e, com -runs, de
+// uma linha do arquivo de execuções)
+struct SimulationOptions {
     int mesh_size = 4;  // malha 4x4 por padrão
     std::string routing_algorithm = "XY";  // roteamento XY por padrão
     int packet_injection_rate = 10;  // taxa de injeção 10% por padrão
     int simulation_time = 1000;  // 1000 ciclos por padrão
-    
+    int stats_epoch = 0;  // amostragem dos contadores dos routers desligada por padrão
+    std::string stats_output = "router_stats";
+    LinkConfig link_config;  // enlaces diretos de 1 ciclo por padrão
+    std::string link_config_file;  // exceções por enlace
+    LinkTable link_table;
+    int watchdog_interval = 100;  // verificação de deadlock a cada 100 ciclos
+    int max_packet_age = -1;  // ciclos parado na cabeça de uma fila até avisar; -1 = min(10000, tempo / 2)
+    bool check_cdg = true;  // verificar o grafo de dependência de canais antes de simular
+    TrafficConfig traffic;  // tráfego uniforme de mão única por padrão
+    std::string traffic_mode = "uniform";
+    std::string memory_controllers;  // cantos da malha por padrão
+    std::string class_mix;  // todos os pacotes na classe de tráfego 0 por padrão
+    std::string multicast_mode = "tree";  // multicast replicado nos routers por padrão
+    std::string packet_sizes;  // todos os pacotes com Packet::SIZE_BYTES por padrão
+    std::string arbitration = "FIXED";  // ordem fixa das portas por padrão
+    std::string arbiter_weights;  // pesos do WRR (padrão: 1,2,4,8)
+    std::vector<int> weights;
+    std::string router_type = "buffered";  // router com buffers de entrada por padrão
+    std::string faults_file;  // malha sem falhas por padrão
+    FaultSchedule faults;
+    std::string clock_domains_file;  // um único clock de 1 ns por padrão
+    ClockDomainConfig clock_domains;
+    std::string checkpoint_file;  // sem checkpoints por padrão
+    int checkpoint_at = -1;
+    int checkpoint_every = 0;
+    std::string restore_file;  // simulação a partir da rede vazia por padrão
+    std::string trace_file;  // sem trace de eventos por padrão
+    std::string trace_windows;  // todos os ciclos por padrão
+    std::string trace_routers;  // todos os routers por padrão
+    std::string trace_flows;  // todos os fluxos por padrão
+    TraceFilter trace_filter;
+    std::string results_file;  // resultados só na saída padrão por padrão
+    std::string live_name;  // sem métricas ao vivo por padrão
+    int live_interval = 1000;  // publicação a cada 1000 ciclos
+    bool estimate_only = false;  // simular por padrão
+    double prune_load = 0;  // simular todos os pontos por padrão
+    int prune_validate = 5;  // simular 1 a cada 5 pontos podados para conferir o modelo
+    bool seeded = false;  // semente aleatória por padrão
+    unsigned seed = 0;
+    std::string runs_file;  // uma única execução por padrão
+    std::string description;  // opções próprias da execução (com -runs)
+};
+
+// Opções que definem a estrutura da rede e não podem mudar entre execuções
+bool isStructuralOption(const std::string& arg) {
+    return arg == "-size" || arg == "-router" || arg == "-link_latency" || arg == "-credit_delay" ||
+           arg == "-link_width" || arg == "-link_config" || arg == "-packet_sizes" || arg == "-clock_domains" ||
+           arg == "-runs" || arg == "-checkpoint" || arg == "-checkpoint_at" || arg == "-checkpoint_every" ||
+           arg == "-live" || arg == "-live_interval";
+}
+
+// Retorno de parse_options quando a simulação deve seguir
+static const int OPTIONS_OK = -1;
+
+// Analisar e validar as opções; retorna OPTIONS_OK ou o código de saída do
+// programa (0 após a ajuda, 1 em erro)
+int parse_options(const std::vector<std::string>& args, const std::string& program, SimulationOptions& options) {
     // Analisar argumentos da linha de comando
-    for (int i = 1; i < argc; i++) {
-        std::string arg = argv[i];
+    for (size_t i = 0; i < args.size(); i++) {
+        const std::string& arg = args[i];
         
-        if (arg == "-size" && i + 1 < argc) {
-            mesh_size = std::atoi(argv[++i]);
-        } else if (arg == "-routing" && i + 1 < argc) {
-            routing_algorithm = argv[++i];
-        } else if (arg == "-rate" && i + 1 < argc) {
-            packet_injection_rate = std::atoi(argv[++i]);
-        } else if (arg == "-time" && i + 1 < argc) {
-            simulation_time = std::atoi(argv[++i]);
+        if (arg == "-size" && i + 1 < args.size()) {
+            options.mesh_size = std::atoi(args[++i].c_str());
+        } else if (arg == "-routing" && i + 1 < args.size()) {
+            options.routing_algorithm = args[++i];
+        } else if (arg == "-rate" && i + 1 < args.size()) {
+            options.packet_injection_rate = std::atoi(args[++i].c_str());
+        } else if (arg == "-time" && i + 1 < args.size()) {
+            options.simulation_time = std::atoi(args[++i].c_str());
+        } else if (arg == "-stats_epoch" && i + 1 < args.size()) {
+            options.stats_epoch = std::atoi(args[++i].c_str());
+        } else if (arg == "-stats_out" && i + 1 < args.size()) {
+            options.stats_output = args[++i];
+        } else if (arg == "-link_latency" && i + 1 < args.size()) {
+            options.link_config.latency = std::atoi(args[++i].c_str());
+        } else if (arg == "-credit_delay" && i + 1 < args.size()) {
+            options.link_config.credit_delay = std::atoi(args[++i].c_str());
+        } else if (arg == "-link_width" && i + 1 < args.size()) {
+            options.link_config.width = std::atoi(args[++i].c_str());
+        } else if (arg == "-link_config" && i + 1 < args.size()) {
+            options.link_config_file = args[++i];
+        } else if (arg == "-packet_sizes" && i + 1 < args.size()) {
+            options.packet_sizes = args[++i];
+        } else if (arg == "-watchdog" && i + 1 < args.size()) {
+            options.watchdog_interval = std::atoi(args[++i].c_str());
+        } else if (arg == "-max_packet_age" && i + 1 < args.size()) {
+            options.max_packet_age = std::atoi(args[++i].c_str());
+        } else if (arg == "-skip_cdg_check") {
+            options.check_cdg = false;
+        } else if (arg == "-traffic" && i + 1 < args.size()) {
+            options.traffic_mode = args[++i];
+        } else if (arg == "-mem_ctrls" && i + 1 < args.size()) {
+            options.memory_controllers = args[++i];
+        } else if (arg == "-service_time" && i + 1 < args.size()) {
+            options.traffic.service_time = std::atoi(args[++i].c_str());
+        } else if (arg == "-max_outstanding" && i + 1 < args.size()) {
+            options.traffic.max_outstanding = std::atoi(args[++i].c_str());
+        } else if (arg == "-class_mix" && i + 1 < args.size()) {
+            options.class_mix = args[++i];
+        } else if (arg == "-multicast" && i + 1 < args.size()) {
+            options.traffic.multicast_rate = std::atoi(args[++i].c_str());
+        } else if (arg == "-multicast_fanout" && i + 1 < args.size()) {
+            options.traffic.multicast_fanout = std::atoi(args[++i].c_str());
+        } else if (arg == "-multicast_mode" && i + 1 < args.size()) {
+            options.multicast_mode = args[++i];
+        } else if (arg == "-arbitration" && i + 1 < args.size()) {
+            options.arbitration = args[++i];
+        } else if (arg == "-wrr_weights" && i + 1 < args.size()) {
+            options.arbiter_weights = args[++i];
+        } else if (arg == "-router" && i + 1 < args.size()) {
+            options.router_type = args[++i];
+        } else if (arg == "-faults" && i + 1 < args.size()) {
+            options.faults_file = args[++i];
+        } else if (arg == "-clock_domains" && i + 1 < args.size()) {
+            options.clock_domains_file = args[++i];
+        } else if (arg == "-checkpoint" && i + 1 < args.size()) {
+            options.checkpoint_file = args[++i];
+        } else if (arg == "-checkpoint_at" && i + 1 < args.size()) {
+            options.checkpoint_at = std::atoi(args[++i].c_str());
+        } else if (arg == "-checkpoint_every" && i + 1 < args.size()) {
+            options.checkpoint_every = std::atoi(args[++i].c_str());
+        } else if (arg == "-restore" && i + 1 < args.size()) {
+            options.restore_file = args[++i];
+        } else if (arg == "-trace" && i + 1 < args.size()) {
+            options.trace_file = args[++i];
+        } else if (arg == "-trace_window" && i + 1 < args.size()) {
+            options.trace_windows = args[++i];
+        } else if (arg == "-trace_routers" && i + 1 < args.size()) {
+            options.trace_routers = args[++i];
+        } else if (arg == "-trace_flows" && i + 1 < args.size()) {
+            options.trace_flows = args[++i];
+        } else if (arg == "-results" && i + 1 < args.size()) {
+            options.results_file = args[++i];
+        } else if (arg == "-live" && i + 1 < args.size()) {
+            options.live_name = args[++i];
+        } else if (arg == "-live_interval" && i + 1 < args.size()) {
+            options.live_interval = std::atoi(args[++i].c_str());
+        } else if (arg == "-estimate") {
+            options.estimate_only = true;
+        } else if (arg == "-prune" && i + 1 < args.size()) {
+            options.prune_load = std::atof(args[++i].c_str());
+        } else if (arg == "-prune_validate" && i + 1 < args.size()) {
+            options.prune_validate = std::atoi(args[++i].c_str());
+        } else if (arg == "-seed" && i + 1 < args.size()) {
+            options.seed = static_cast<unsigned>(std::strtoul(args[++i].c_str(), nullptr, 10));
+            options.seeded = true;
+        } else if (arg == "-runs" && i + 1 < args.size()) {
+            options.runs_file = args[++i];
         } else if (arg == "-help" || arg == "-h") {
-            std::cout << "Uso: " << argv[0] << " [opções]" << std::endl;
+            std::cout << "Uso: " << program << " [opções]" << std::endl;
             std::cout << "Opções:" << std::endl;
             std::cout << "  -size TAMANHO     Define o tamanho da malha (padrão: 4)" << std::endl;
-            std::cout << "  -routing ALGO     Define o algoritmo de roteamento: XY, WEST_FIRST (padrão: XY)" << std::endl;
+            std::cout << "  -routing ALGO     Define o algoritmo de roteamento: XY, WEST_FIRST, UP_DOWN (padrão: XY)" << std::endl;
             std::cout << "  -rate TAXA        Define a taxa de injeção de pacotes em porcentagem (padrão: 10)" << std::endl;
             std::cout << "  -time TEMPO       Define o tempo de simulação em ciclos (padrão: 1000)" << std::endl;
+            std::cout << "  -stats_epoch N    Amostra contadores dos routers a cada N ciclos (padrão: 0, desligado)" << std::endl;
+            std::cout << "  -stats_out PREFIXO Arquivos da série temporal PREFIXO.csv/.json (padrão: router_stats)" << std::endl;
+            std::cout << "  -link_latency N   Latência dos enlaces entre routers em ciclos (padrão: 1)" << std::endl;
+            std::cout << "  -credit_delay N   Ciclos para o crédito de uma vaga liberada no router voltar ao enlace (padrão: 0)" << std::endl;
+            std::cout << "  -link_width B     Largura dos enlaces em bytes por ciclo (padrão: " << Packet::SIZE_BYTES << ")" << std::endl;
+            std::cout << "  -link_config ARQ  Enlaces específicos: linhas \"router_a router_b latência largura [crédito]\"" << std::endl;
+            std::cout << "  -packet_sizes B:P,.. Tamanhos dos pacotes em bytes e suas porcentagens, ex. 8:50,64:50 (padrão: "
+                      << Packet::SIZE_BYTES << ":100)" << std::endl;
+            std::cout << "  -watchdog N       Verifica deadlock/livelock a cada N ciclos (padrão: 100, 0 desliga)" << std::endl;
+            std::cout << "  -max_packet_age N Avisa se um pacote ficar parado na cabeça de uma fila por mais de N ciclos"
+                      << " (padrão: min(10000, tempo/2), 0 desliga)" << std::endl;
+            std::cout << "  -skip_cdg_check   Não verifica o grafo de dependência de canais antes de simular" << std::endl;
+            std::cout << "  -traffic MODO     Modo de tráfego: uniform, request_reply (padrão: uniform)" << std::endl;
+            std::cout << "  -mem_ctrls LISTA  Nós controladores de memória, ex. 0,3,12,15 (padrão: cantos da malha)" << std::endl;
+            std::cout << "  -service_time N   Ciclos até o controlador de memória responder (padrão: 10)" << std::endl;
+            std::cout << "  -max_outstanding N Pedidos pendentes por nó no modo request_reply (padrão: 4)" << std::endl;
+            std::cout << "  -class_mix P0,P1,.. Porcentagem dos pacotes em cada classe de tráfego 0-" << Packet::NUM_TRAFFIC_CLASSES - 1
+                      << ", soma 100 (padrão: 100)" << std::endl;
+            std::cout << "  -multicast P      Porcentagem dos pacotes do tráfego uniforme que são multicast (padrão: 0)" << std::endl;
+            std::cout << "  -multicast_fanout K Destinos sorteados de cada multicast (padrão: 0, broadcast a todos os nós)" << std::endl;
+            std::cout << "  -multicast_mode M Multicast: tree (replicado nos routers), unicast (uma cópia por destino na origem)" << std::endl;
+            std::cout << "  -arbitration POL  Arbitragem das saídas: FIXED, PRIORITY, WRR, OLDEST_FIRST (padrão: FIXED)" << std::endl;
+            std::cout << "  -wrr_weights W0,W1,.. Pesos do WRR por classe de tráfego (padrão: 1,2,4,8)" << std::endl;
+            std::cout << "  -router TIPO      Router: buffered, bufferless (desvio, mais antigo primeiro) (padrão: buffered)" << std::endl;
+            std::cout << "  -faults ARQ       Falhas: linhas \"link a b [ciclo]\" ou \"router r [ciclo]\" (ciclo 0 = desde o início)" << std::endl;
+            std::cout << "  -clock_domains ARQ Domínios de clock: linhas \"domain ID PERÍODO_NS\", \"routers ID LISTA\", \"nodes ID LISTA|all\"," << std::endl;
+            std::cout << "                    \"dvfs ID TEMPO_NS PERÍODO_NS\" e \"crossing ESTÁGIOS PROFUNDIDADE\" (padrão: um clock de 1 ns)" << std::endl;
+            std::cout << "  -checkpoint ARQ   Grava o estado completo da simulação em ARQ (com -checkpoint_at/-checkpoint_every)" << std::endl;
+            std::cout << "  -checkpoint_at N  Grava o checkpoint após o ciclo N (ex.: fim do aquecimento)" << std::endl;
+            std::cout << "  -checkpoint_every N Grava o checkpoint a cada N ciclos, substituindo o anterior" << std::endl;
+            std::cout << "  -restore ARQ      Continua a partir de um checkpoint da mesma rede (taxa, tráfego e roteamento podem mudar)" << std::endl;
+            std::cout << "  -trace ARQ        Grava o trace binário de eventos dos pacotes (injeção, salto, perda de arbitragem, entrega)" << std::endl;
+            std::cout << "  -trace_window A:B,.. Limita o trace às janelas de ciclos (padrão: todos)" << std::endl;
+            std::cout << "  -trace_routers LISTA Limita o trace aos routers da lista (padrão: todos)" << std::endl;
+            std::cout << "  -trace_flows S:D,.. Limita o trace aos fluxos unicast origem:destino (padrão: todos)" << std::endl;
+            std::cout << "  -results ARQ      Acrescenta as métricas da execução ao arquivo de resultados (ver results_aggregator)" << std::endl;
+            std::cout << "  -live NOME        Publica progresso e métricas ao vivo na memória compartilhada NOME (ver live_monitor)" << std::endl;
+            std::cout << "  -live_interval N  Ciclos entre publicações das métricas ao vivo (padrão: 1000)" << std::endl;
+            std::cout << "  -estimate         Só estima latência, gargalo e saturação pelo modelo analítico, sem simular" << std::endl;
+            std::cout << "  -prune U          Não simula os pontos que o modelo estima com segurança (gargalo abaixo de U, 0-1)" << std::endl;
+            std::cout << "  -prune_validate N Simula 1 a cada N pontos podados para conferir o modelo (padrão: 5, 0 = nenhum)" << std::endl;
+            std::cout << "  -seed N           Semente dos geradores aleatórios dos nós; repete a execução exatamente (padrão: aleatória)" << std::endl;
+            std::cout << "  -runs ARQ         Executa em sequência na mesma rede as configurações de ARQ, uma por linha, com as" << std::endl;
+            std::cout << "                    opções que mudam entre execuções (-rate, -time, -routing, -traffic, -seed, -faults...)" << std::endl;
             std::cout << "  -help, -h         Mostra esta mensagem de ajuda" << std::endl;
             return 0;
         }
     }
     
     // Validar parâmetros
-    if (mesh_size < 2 || mesh_size > 16) {
+    if (options.mesh_size < 2 || options.mesh_size > 16) {
         std::cout << "Erro: Tamanho da malha deve estar entre 2 e 16" << std::endl;
         return 1;
     }
     
-    if (routing_algorithm != "XY" && routing_algorithm != "WEST_FIRST") {
-        std::cout << "Erro: Algoritmo de roteamento desconhecido. Suportados: XY, WEST_FIRST" << std::endl;
+    if (options.routing_algorithm != "XY" && options.routing_algorithm != "WEST_FIRST" && options.routing_algorithm != "UP_DOWN") {
+        std::cout << "Erro: Algoritmo de roteamento desconhecido. Suportados: XY, WEST_FIRST, UP_DOWN" << std::endl;
         return 1;
     }
     
-    if (packet_injection_rate < 1 || packet_injection_rate > 100) {
+    if (options.packet_injection_rate < 1 || options.packet_injection_rate > 100) {
         std::cout << "Erro: Taxa de injeção de pacotes deve estar entre 1 e 100" << std::endl;
         return 1;
     }
     
-    if (simulation_time < 100) {
+    if (options.simulation_time < 100) {
         std::cout << "Erro: Tempo de simulação deve ser pelo menos 100 ciclos" << std::endl;
         return 1;
     }
     
-    // Executar simulação com o algoritmo especificado
-    std::cout << "Executando simulação com algoritmo de roteamento " << routing_algorithm << "..." << std::endl;
-    run_simulation(mesh_size, routing_algorithm, packet_injection_rate, simulation_time);
+    if (options.stats_epoch < 0) {
+        std::cout << "Erro: Período de amostragem deve ser não negativo" << std::endl;
+        return 1;
+    }
+    
+    if (options.link_config.latency < 1 || options.link_config.credit_delay < 0 || options.link_config.width < 1) {
+        std::cout << "Erro: Latência e largura dos enlaces devem ser positivas e o atraso de crédito não negativo" << std::endl;
+        return 1;
+    }
+    
+    options.link_table = LinkTable(options.link_config);
+    if (!options.link_config_file.empty()) {
+        std::string error;
+        if (!options.link_table.loadFromFile(options.link_config_file, error)) {
+            std::cout << "Erro: Configuração de enlaces: " << error << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!options.packet_sizes.empty() &&
+        !TrafficConfig::parseSizeMix(options.packet_sizes, Packet::MAX_SIZE_BYTES, options.traffic.packet_sizes)) {
+        std::cout << "Erro: Tamanhos de pacote devem ser pares bytes:porcentagem com 1 a " << Packet::MAX_SIZE_BYTES
+                  << " bytes e porcentagens somando 100" << std::endl;
+        return 1;
+    }
+    
+    if (options.watchdog_interval < 0 || options.max_packet_age < -1) {
+        std::cout << "Erro: Parâmetros do watchdog devem ser não negativos" << std::endl;
+        return 1;
+    }
+    if (options.max_packet_age < 0) {
+        options.max_packet_age = std::min(10000, options.simulation_time / 2);
+    }
+    
+    if (!TrafficConfig::parseMode(options.traffic_mode, options.traffic.mode)) {
+        std::cout << "Erro: Modo de tráfego desconhecido. Suportados: uniform, request_reply" << std::endl;
+        return 1;
+    }
+    
+    if (options.traffic.mode == TrafficConfig::REQUEST_REPLY) {
+        if (options.memory_controllers.empty()) {
+            options.traffic.memory_controllers = TrafficConfig::defaultMemoryControllers(options.mesh_size, options.mesh_size);
+        } else if (!TrafficConfig::parseIntList(options.memory_controllers, options.traffic.memory_controllers)) {
+            std::cout << "Erro: Lista de controladores de memória inválida: " << options.memory_controllers << std::endl;
+            return 1;
+        }
+        
+        for (int node_id : options.traffic.memory_controllers) {
+            if (node_id < 0 || node_id >= options.mesh_size * options.mesh_size) {
+                std::cout << "Erro: Controlador de memória " << node_id << " fora da malha" << std::endl;
+                return 1;
+            }
+        }
+        
+        if (static_cast<int>(options.traffic.memory_controllers.size()) >= options.mesh_size * options.mesh_size) {
+            std::cout << "Erro: Pelo menos um nó deve ficar fora dos controladores de memória" << std::endl;
+            return 1;
+        }
+        
+        if (options.traffic.service_time < 0 || options.traffic.max_outstanding < 1) {
+            std::cout << "Erro: Tempo de serviço deve ser não negativo e pedidos pendentes pelo menos 1" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (!options.class_mix.empty()) {
+        int total = 0;
+        bool valid = TrafficConfig::parseIntList(options.class_mix, options.traffic.class_mix) &&
+                     static_cast<int>(options.traffic.class_mix.size()) <= Packet::NUM_TRAFFIC_CLASSES;
+        for (size_t c = 0; valid && c < options.traffic.class_mix.size(); c++) {
+            valid = options.traffic.class_mix[c] >= 0;
+            total += options.traffic.class_mix[c];
+        }
+        if (!valid || total != 100) {
+            std::cout << "Erro: Mistura de classes deve ter até " << Packet::NUM_TRAFFIC_CLASSES
+                      << " porcentagens não negativas somando 100" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (options.traffic.multicast_rate < 0 || options.traffic.multicast_rate > 100 || options.traffic.multicast_fanout < 0) {
+        std::cout << "Erro: -multicast deve estar entre 0 e 100 e -multicast_fanout não pode ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if (options.multicast_mode != "tree" && options.multicast_mode != "unicast") {
+        std::cout << "Erro: Modo de multicast desconhecido. Suportados: tree, unicast" << std::endl;
+        return 1;
+    }
+    options.traffic.multicast_as_unicast = options.multicast_mode == "unicast";
+    
+    if (options.traffic.multicast_rate > 0 && options.traffic.mode != TrafficConfig::UNIFORM) {
+        std::cout << "Erro: Multicast só é gerado no tráfego uniforme" << std::endl;
+        return 1;
+    }
+    
+    if (options.arbitration != "FIXED" && options.arbitration != "PRIORITY" && options.arbitration != "WRR" && options.arbitration != "OLDEST_FIRST") {
+        std::cout << "Erro: Política de arbitragem desconhecida. Suportadas: FIXED, PRIORITY, WRR, OLDEST_FIRST" << std::endl;
+        return 1;
+    }
+    
+    options.weights = defaultArbiterWeights();
+    if (!options.arbiter_weights.empty()) {
+        bool valid = TrafficConfig::parseIntList(options.arbiter_weights, options.weights) &&
+                     static_cast<int>(options.weights.size()) == Packet::NUM_TRAFFIC_CLASSES;
+        for (size_t c = 0; valid && c < options.weights.size(); c++) {
+            valid = options.weights[c] >= 1;
+        }
+        if (!valid) {
+            std::cout << "Erro: Pesos do WRR devem ser " << Packet::NUM_TRAFFIC_CLASSES
+                      << " inteiros positivos" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (options.router_type != "buffered" && options.router_type != "bufferless") {
+        std::cout << "Erro: Tipo de router desconhecido. Suportados: buffered, bufferless" << std::endl;
+        return 1;
+    }
+    
+    if (options.router_type == "bufferless") {
+        if (!options.link_table.allDirect(options.traffic.maxPacketBytes(Packet::SIZE_BYTES))) {
+            std::cout << "Erro: O router sem buffers exige enlaces diretos (latência 1, largura do maior pacote, sem atraso de crédito)" << std::endl;
+            return 1;
+        }
+        if (options.arbitration != "FIXED") {
+            std::cout << "Aviso: -arbitration ignorado; o router sem buffers prioriza sempre o pacote mais antigo" << std::endl;
+        }
+        if (options.traffic.multicast_rate > 0) {
+            std::cout << "Erro: O router sem buffers não replica pacotes; use -router buffered para multicast" << std::endl;
+            return 1;
+        }
+        // Sem buffers não há dependência entre canais: desvios dispensam a verificação do CDG
+        options.check_cdg = false;
+    }
+    
+    if (!options.faults_file.empty()) {
+        std::string error;
+        if (!options.faults.loadFromFile(options.faults_file, options.mesh_size, options.mesh_size, error)) {
+            std::cout << "Erro: Arquivo de falhas: " << error << std::endl;
+            return 1;
+        }
+        if (options.routing_algorithm != "UP_DOWN") {
+            std::cout << "Aviso: " << options.routing_algorithm << " não contorna falhas; pacotes que passem "
+                      << "por componentes falhos ficarão bloqueados (use -routing UP_DOWN)" << std::endl;
+        }
+        for (const FaultEvent& event : options.faults.getEvents()) {
+            if (event.cycle >= options.simulation_time) {
+                std::cout << "Aviso: Falha de " << event.describe() << " no ciclo " << event.cycle
+                          << " ignorada (após o fim da geração de pacotes)" << std::endl;
+            }
+        }
+    }
+    
+    if (!options.clock_domains_file.empty()) {
+        std::string error;
+        if (!options.clock_domains.loadFromFile(options.clock_domains_file, options.mesh_size * options.mesh_size, error)) {
+            std::cout << "Erro: Arquivo de domínios de clock: " << error << std::endl;
+            return 1;
+        }
+        // As FIFOs de sincronização seguram pacotes, e o router sem buffers
+        // precisa encaminhar todo pacote que chega no mesmo ciclo
+        if (options.router_type == "bufferless" && options.clock_domains.isMultiClock()) {
+            std::cout << "Erro: O router sem buffers exige um único domínio de clock" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (options.checkpoint_file.empty() != (options.checkpoint_at < 0 && options.checkpoint_every <= 0)) {
+        std::cout << "Erro: -checkpoint exige -checkpoint_at ou -checkpoint_every (e vice-versa)" << std::endl;
+        return 1;
+    }
+    if ((!options.checkpoint_file.empty() || !options.restore_file.empty()) && options.clock_domains.isMultiClock()) {
+        std::cout << "Erro: Checkpoints exigem um único domínio de clock" << std::endl;
+        return 1;
+    }
+    options.trace_filter = TraceFilter(options.mesh_size * options.mesh_size);
+    if (!options.trace_windows.empty() && !options.trace_filter.parseWindows(options.trace_windows)) {
+        std::cout << "Erro: Janelas do trace devem ser INÍCIO:FIM com 0 <= INÍCIO <= FIM" << std::endl;
+        return 1;
+    }
+    if (!options.trace_routers.empty() && !options.trace_filter.parseRouters(options.trace_routers)) {
+        std::cout << "Erro: Lista de routers do trace inválida: " << options.trace_routers << std::endl;
+        return 1;
+    }
+    if (!options.trace_flows.empty() && !options.trace_filter.parseFlows(options.trace_flows)) {
+        std::cout << "Erro: Fluxos do trace devem ser ORIGEM:DESTINO com nós da malha" << std::endl;
+        return 1;
+    }
+    if (options.trace_file.empty() &&
+        !(options.trace_windows.empty() && options.trace_routers.empty() && options.trace_flows.empty())) {
+        std::cout << "Aviso: filtros do trace ignorados sem -trace ARQ" << std::endl;
+    }
+    
+    if (!options.live_name.empty() && !LiveMetricsMapping::isValidName(options.live_name)) {
+        std::cout << "Erro: Nome das métricas ao vivo deve ter até 64 letras, dígitos, '_' ou '-'" << std::endl;
+        return 1;
+    }
+    if (options.live_interval < 1) {
+        std::cout << "Erro: -live_interval deve ser positivo" << std::endl;
+        return 1;
+    }
     
+    if (options.prune_load < 0 || options.prune_load >= 1 || options.prune_validate < 0) {
+        std::cout << "Erro: -prune deve estar entre 0 e 1 e -prune_validate não pode ser negativo" << std::endl;
+        return 1;
+    }
+    
+    if (!options.checkpoint_file.empty() && !options.runs_file.empty()) {
+        std::cout << "Erro: -checkpoint não pode ser usado com -runs (cada execução substituiria o arquivo)" << std::endl;
+        return 1;
+    }
+    
+    // Verificação estática de deadlock do algoritmo de roteamento; UP_DOWN é
+    // verificado sobre as tabelas da malha com as falhas presentes desde o início
+    if (options.check_cdg && options.routing_algorithm == "UP_DOWN") {
+        MeshFaults static_faults(options.mesh_size, options.mesh_size);
+        for (const FaultEvent& event : options.faults.getEvents()) {
+            if (event.cycle == 0) {
+                static_faults.apply(event);
+            }
+        }
+        auto table = std::make_shared<UpDownRoutingTable>();
+        table->rebuild(static_faults);
+        UpDownRoutingAlgorithm routing(table, options.mesh_size);
+        std::vector<bool> reachable(options.mesh_size * options.mesh_size);
+        for (int r = 0; r < options.mesh_size * options.mesh_size; r++) {
+            reachable[r] = static_faults.isRouterAlive(r) && table->isReachable(r);
+            if (static_faults.isRouterAlive(r) && !reachable[r]) {
+                std::cout << "Aviso: Router " << r << " isolado pelas falhas; seu nó não participa do tráfego" << std::endl;
+            }
+        }
+        std::string cdg_report;
+        if (!checkRoutingDeadlockFreedom(routing, options.mesh_size, options.mesh_size, cdg_report, reachable)) {
+            std::cout << "Erro: Roteamento UP_DOWN inválido para as falhas iniciais: " << cdg_report << std::endl;
+            return 1;
+        }
+    } else if (options.check_cdg) {
+        std::string cdg_report;
+        if (!checkRoutingDeadlockFreedom(options.routing_algorithm, options.mesh_size, options.mesh_size, cdg_report)) {
+            std::cout << "Erro: Roteamento " << options.routing_algorithm << " sujeito a deadlock: " << cdg_report << std::endl;
+            return 1;
+        }
+    }
+    
+#ifndef NOC_ROUTER_STATS
+    if (options.stats_epoch > 0) {
+        std::cout << "Aviso: -stats_epoch ignorado; compile com ROUTER_STATS=1 para habilitar os contadores" << std::endl;
+    }
+#endif
+    
+    return OPTIONS_OK;
+}
+
+// Ler o arquivo de execuções: cada linha (vazias e iniciadas por '#' são
+// ignoradas) são opções aplicadas sobre as da linha de comando
+int parse_runs(const std::vector<std::string>& args, const std::string& program, const SimulationOptions& base,
+               std::vector<SimulationOptions>& runs) {
+    std::ifstream in(base.runs_file);
+    if (!in) {
+        std::cout << "Erro: Arquivo de execuções: não foi possível abrir " << base.runs_file << std::endl;
+        return 1;
+    }
+    
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        line_number++;
+        std::istringstream fields(line);
+        std::vector<std::string> run_args;
+        std::string field;
+        while (fields >> field) {
+            run_args.push_back(field);
+        }
+        if (run_args.empty() || run_args[0][0] == '#') {
+            continue;
+        }
+        
+        std::string location = base.runs_file + ":" + std::to_string(line_number);
+        for (const std::string& arg : run_args) {
+            if (isStructuralOption(arg) || arg == "-help" || arg == "-h") {
+                std::cout << "Erro: " << location << ": " << arg << " não pode mudar entre execuções" << std::endl;
+                return 1;
+            }
+        }
+        
+        std::vector<std::string> combined(args);
+        combined.insert(combined.end(), run_args.begin(), run_args.end());
+        SimulationOptions run;
+        int status = parse_options(combined, program, run);
+        if (status != OPTIONS_OK) {
+            std::cout << "Erro: " << location << ": configuração inválida" << std::endl;
+            return 1;
+        }
+        for (const std::string& arg : run_args) {
+            run.description += (run.description.empty() ? "" : " ") + arg;
+        }
+        runs.push_back(run);
+    }
+    
+    if (runs.empty()) {
+        std::cout << "Erro: Arquivo de execuções " << base.runs_file << " sem nenhuma configuração" << std::endl;
+        return 1;
+    }
+    return OPTIONS_OK;
+}
+
+// Nome de um arquivo de saída da execução k (1, 2, ...) de uma varredura:
+// "saida.trace" -> "saida_run2.trace"
+std::string run_file_name(const std::string& filename, size_t k) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = filename.size();
+    }
+    return filename.substr(0, dot) + "_run" + std::to_string(k) + filename.substr(dot);
+}
+
+// Configuração de uma execução como chave do arquivo de resultados: tudo o
+// que muda as métricas, exceto a semente (gravada à parte), e a origem das
+// métricas ("simulation" ou "model", ponto estimado pelo modelo analítico).
+// restore_cycle é o primeiro ciclo medido de uma execução restaurada de um
+// checkpoint (-1 quando não simulada), para ela não se misturar às que
+// começam do zero nem às restauradas em outro ciclo
+std::vector<std::pair<std::string, std::string>> results_config(const SimulationOptions& run, const std::string& source,
+                                                                int restore_cycle) {
+    auto text = [](const std::string& value) { return value.empty() ? std::string("-") : value; };
+    std::vector<std::pair<std::string, std::string>> config = {
+        {"size", std::to_string(run.mesh_size)},
+        {"router", run.router_type},
+        {"routing", run.routing_algorithm},
+        {"rate", std::to_string(run.packet_injection_rate)},
+        {"time", std::to_string(run.simulation_time)},
+        {"traffic", run.traffic_mode},
+        {"memory_controllers", text(run.memory_controllers)},
+        {"class_mix", text(run.class_mix)},
+        {"arbitration", run.arbitration},
+        {"weights", text(run.arbiter_weights)},
+        {"link_latency", std::to_string(run.link_config.latency)},
+        {"credit_delay", std::to_string(run.link_config.credit_delay)},
+        {"link_width", std::to_string(run.link_config.width)},
+        {"link_config", text(run.link_config_file)},
+        {"faults", text(run.faults_file)},
+        {"clock_domains", text(run.clock_domains_file)},
+        {"restore", text(run.restore_file)}
+    };
+    // Só com tamanhos ou multicast, para não mudar a chave dos resultados já gravados
+    if (!run.packet_sizes.empty()) {
+        config.push_back({"packet_sizes", run.packet_sizes});
+    }
+    if (run.traffic.multicast_rate > 0) {
+        config.push_back({"multicast", std::to_string(run.traffic.multicast_rate)});
+        config.push_back({"multicast_fanout", std::to_string(run.traffic.multicast_fanout)});
+        config.push_back({"multicast_mode", run.multicast_mode});
+    }
+    if (!run.restore_file.empty()) {
+        config.push_back({"restore_cycle", restore_cycle >= 0 ? std::to_string(restore_cycle) : std::string("-")});
+    }
+    config.push_back({"source", source});
+    return config;
+}
+
+// Período do clock de referência em ns (1 ns sem domínios de clock)
+double reference_period_ns(const SimulationOptions& run) {
+    return run.clock_domains.periods_ns.empty() ? 1.0 : run.clock_domains.periods_ns[0];
+}
+
+// Estimar uma execução pelo modelo analítico, anotando o que ele não representa
+bool estimate_run(const SimulationOptions& run, PerformanceEstimate& estimate) {
+    std::string error;
+    if (!estimateConfiguration(run.mesh_size, run.mesh_size, run.routing_algorithm, run.packet_injection_rate,
+                               run.traffic, run.link_table, run.faults, estimate, error)) {
+        std::cout << "Aviso: Modelo analítico: " << error << std::endl;
+        return false;
+    }
+    if (run.router_type == "bufferless") {
+        estimate.caveats.push_back("desvios do router sem buffers não entram no modelo");
+    }
+    if (run.clock_domains.isMultiClock()) {
+        estimate.caveats.push_back("modelo usa um único clock de " + std::to_string(reference_period_ns(run)) + " ns");
+    }
+    if (run.traffic.multicast_rate > 0) {
+        estimate.caveats.push_back("pacotes multicast modelados como unicast");
+    }
+    return true;
+}
+
+void print_estimate(const SimulationOptions& run, const PerformanceEstimate& estimate) {
+    double period_ns = reference_period_ns(run);
+    int num_nodes = run.mesh_size * run.mesh_size;
+    std::cout << "\n-------- Analytical Estimate --------" << std::endl;
+    std::cout << "Offered Load=" << estimate.offered_load << " packets/cycle ("
+              << estimate.offered_load / num_nodes << " packets/node/cycle)" << std::endl;
+    if (estimate.bottleneck_router >= 0) {
+        std::cout << "Bottleneck: R" << estimate.bottleneck_router << "." << directionName(estimate.bottleneck_port)
+                  << ", Utilization=" << 100.0 * estimate.bottleneck_utilization << "%" << std::endl;
+        std::cout << "Saturation Bound: Injection Rate="
+                  << run.packet_injection_rate / estimate.bottleneck_utilization << "%"
+                  << ", Throughput=" << estimate.saturation_load << " packets/cycle ("
+                  << estimate.saturation_load * 1000.0 / period_ns << " packets/us)" << std::endl;
+    }
+    if (estimate.saturated) {
+        std::cout << "Estimate: saturated (bottleneck above 100%), latency unbounded" << std::endl;
+    } else {
+        std::cout << "Estimate: Avg Latency=" << estimate.avg_latency << " cycles ("
+                  << estimate.avg_latency * period_ns << " ns)"
+                  << ", Avg Hops=" << estimate.avg_hops
+                  << ", P50=" << estimate.p50_latency << ", P95=" << estimate.p95_latency
+                  << ", P99=" << estimate.p99_latency << std::endl;
+    }
+    for (const std::string& caveat : estimate.caveats) {
+        std::cout << "Model Caveat: " << caveat << std::endl;
+    }
+}
+
+// Métricas de um ponto podado, na ordem de RunResult::metricNames(): sem
+// saturação todos os pacotes gerados são entregues
+std::vector<double> estimate_metrics(const SimulationOptions& run, const PerformanceEstimate& estimate) {
+    double packets = estimate.offered_load * run.simulation_time;
+    return {packets, packets, estimate.offered_load, 100.0, estimate.avg_latency, estimate.p50_latency,
+            estimate.p95_latency, estimate.p99_latency, estimate.max_latency, estimate.avg_hops, 0.0, 0.0,
+            estimate.offered_load * run.traffic.meanPacketBytes(Packet::SIZE_BYTES)};
+}
+
+// Acrescentar as métricas de uma execução ao arquivo de resultados, se pedido
+bool record_results(const SimulationOptions& run, const std::string& source, int restore_cycle,
+                    const std::vector<double>& metrics) {
+    if (run.results_file.empty()) {
+        return true;
+    }
+    RunResult result;
+    result.config = results_config(run, source, restore_cycle);
+    result.seeded = run.seeded;
+    result.seed = run.seed;
+    result.metrics = metrics;
+    std::string error;
+    if (!appendRunResult(run.results_file, result, error)) {
+        std::cout << "Erro: Resultados: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Executar as configurações em sequência sobre uma única rede, construída
+// com a primeira e reiniciada com NoC::reset antes de cada uma das demais.
+// Com -prune, os pontos que o modelo analítico estima com segurança (sem
+// ressalvas e com o gargalo abaixo do limite) não são simulados, exceto 1 a
+// cada prune_validate, simulado para conferir a estimativa. Retorna 0 ao
+// completar, 1 se um checkpoint não pôde ser restaurado, o segmento das
+// métricas ao vivo não pôde ser criado ou um arquivo de saída não pôde ser
+// gravado e 2 se o watchdog abortou uma execução (as seguintes são canceladas)
+int run_simulation(const std::vector<SimulationOptions>& runs) {
+    // Criar NoC
+    const SimulationOptions& first = runs.front();
+    NoC noc("network_on_chip", first.mesh_size, first.mesh_size,
+            first.routing_algorithm, first.packet_injection_rate, first.simulation_time, first.link_table,
+            first.router_type, first.clock_domains, first.traffic.maxPacketBytes(Packet::SIZE_BYTES));
+    if (!first.live_name.empty()) {
+        std::string error;
+        if (!noc.setLiveMetrics(first.live_name, first.live_interval, error)) {
+            std::cout << "Erro: Métricas ao vivo: " << error << std::endl;
+            return 1;
+        }
+        std::cout << "Métricas ao vivo a cada " << first.live_interval << " ciclos: live_monitor "
+                  << first.live_name << std::endl;
+    }
+    
+    size_t simulated = 0;
+    int pruned = 0;
+    for (size_t k = 0; k < runs.size(); k++) {
+        const SimulationOptions& run = runs[k];
+        std::string stats_output = run.stats_output;
+        if (runs.size() > 1) {
+            std::cout << "\n======== Execução " << k + 1 << " de " << runs.size() << ": "
+                      << run.description << " ========" << std::endl;
+            stats_output += "_run" + std::to_string(k + 1);
+        }
+        
+        PerformanceEstimate estimate;
+        bool validating = false;
+        if (run.prune_load > 0 && estimate_run(run, estimate) && estimate.caveats.empty() &&
+            !estimate.saturated && estimate.bottleneck_utilization < run.prune_load) {
+            pruned++;
+            validating = run.prune_validate > 0 && pruned % run.prune_validate == 0;
+            if (!validating) {
+                std::cout << "Ponto estimado pelo modelo analítico, sem simulação" << std::endl;
+                print_estimate(run, estimate);
+                if (!record_results(run, "model", -1, estimate_metrics(run, estimate))) {
+                    return 1;
+                }
+                continue;
+            }
+            std::cout << "Ponto de validação do modelo analítico" << std::endl;
+        }
+        
+        if (simulated > 0) {
+            noc.reset();
+        }
+        if (k > 0) {
+            noc.setRoutingAlgorithm(run.routing_algorithm);
+            noc.setInjectionRate(run.packet_injection_rate);
+            noc.setSimulationTime(run.simulation_time);
+        }
+        if (run.seeded) {
+            noc.setSeed(run.seed);
+        }
+        noc.setStatsEpoch(run.stats_epoch, stats_output);
+        noc.setWatchdog(run.watchdog_interval, run.max_packet_age);
+        noc.setTraffic(run.traffic);
+        noc.setArbitration(run.arbitration, run.weights);
+        if (!run.restore_file.empty()) {
+            std::string error;
+            if (!noc.loadCheckpoint(run.restore_file, error)) {
+                std::cout << "Erro: Checkpoint: " << error << std::endl;
+                return 1;
+            }
+        }
+        noc.setFaults(run.faults);
+        noc.setCheckpoint(run.checkpoint_file, run.checkpoint_at, run.checkpoint_every);
+        if (!run.trace_file.empty()) {
+            std::string error;
+            std::string trace_file = runs.size() > 1 ? run_file_name(run.trace_file, k + 1) : run.trace_file;
+            if (!noc.setTrace(trace_file, run.trace_filter, error)) {
+                std::cout << "Erro: Trace: " << error << std::endl;
+                return 1;
+            }
+        }
+        
+        // Simular até o fim da execução
+        std::cout << "Executando simulação com algoritmo de roteamento " << run.routing_algorithm << "..." << std::endl;
+        sc_start(noc.getRunDuration());
+        simulated++;
+        if (noc.wasAborted()) {
+            if (k + 1 < runs.size()) {
+                std::cout << "Execuções restantes canceladas após o watchdog" << std::endl;
+            }
+            return 2;
+        }
+        std::vector<double> metrics = noc.getRunMetrics();
+        if (validating) {
+            double simulated_latency = metrics[RunResult::metricIndex("avg_latency")];
+            print_estimate(run, estimate);
+            std::cout << "Model Validation: Estimated Latency=" << estimate.avg_latency
+                      << ", Simulated Latency=" << simulated_latency
+                      << ", Error=" << (simulated_latency > 0 ? 100.0 * (estimate.avg_latency - simulated_latency) / simulated_latency : 0.0)
+                      << "%" << std::endl;
+        }
+        if (!record_results(run, "simulation", noc.getStartCycle(), metrics)) {
+            return 1;
+        }
+    }
+    if (pruned > 0) {
+        std::cout << "\nPoda pelo modelo analítico: " << runs.size() - simulated << " de " << runs.size()
+                  << " pontos estimados sem simulação" << std::endl;
+    }
     return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char* argv[]) {
+    // Inicializar gerador de números aleatórios
+    std::srand(std::time(nullptr));
+    
+    std::vector<std::string> args(argv + 1, argv + argc);
+    SimulationOptions options;
+    int status = parse_options(args, argv[0], options);
+    if (status != OPTIONS_OK) {
+        return status;
+    }
+    
+    std::vector<SimulationOptions> runs;
+    if (options.runs_file.empty()) {
+        runs.push_back(options);
+    } else {
+        status = parse_runs(args, argv[0], options, runs);
+        if (status != OPTIONS_OK) {
+            return status;
+        }
+    }
+    
+    // Só o modelo analítico: nenhuma rede é construída
+    if (options.estimate_only) {
+        for (size_t k = 0; k < runs.size(); k++) {
+            if (runs.size() > 1) {
+                std::cout << "\n======== Execução " << k + 1 << " de " << runs.size() << ": "
+                          << runs[k].description << " ========" << std::endl;
+            }
+            PerformanceEstimate estimate;
+            if (!estimate_run(runs[k], estimate)) {
+                return 1;
+            }
+            print_estimate(runs[k], estimate);
+        }
+        return 0;
+    }
+    
+    return run_simulation(runs);
+}
@@ -2,13 +2,27 @@
 #define NOC_H
 
 #include <systemc.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <vector>
 #include <memory>
 #include <string>
 #include "node.h"
 #include "router.h"
+#include "deflection_router.h"
 #include "channel.h"
 #include "routing_algorithms.h"
+#include "router_stats.h"
+#include "deadlock.h"
+#include "scoreboard.h"
+#include "traffic.h"
+#include "fault_tolerance.h"
+#include "clock_domains.h"
+#include "checkpoint.h"
+#include "event_trace.h"
+#include "results_store.h"
+#include "live_metrics.h"
 
 // Classe Network-on-Chip
 class NoC : public sc_module {
@@ -16,23 +30,55 @@ public:
     // Construtor
     NoC(sc_module_name name, int mesh_size_x, int mesh_size_y, 
         const std::string& routing_algorithm_name,
-        int packet_injection_rate = 10, int simulation_time = 1000) : 
+        int packet_injection_rate = 10, int simulation_time = 1000,
+        const LinkTable& link_table = LinkTable(),
+        const std::string& router_type = "buffered",
+        const ClockDomainConfig& clock_domains = ClockDomainConfig(),
+        int max_packet_bytes = Packet::SIZE_BYTES) : 
         sc_module(name),
         mesh_size_x_(mesh_size_x),
         mesh_size_y_(mesh_size_y),
         packet_injection_rate_(packet_injection_rate),
         simulation_time_(simulation_time),
-        routing_algorithm_name_(routing_algorithm_name) {
+        routing_algorithm_name_(routing_algorithm_name),
+        link_table_(link_table),
+        max_packet_bytes_(max_packet_bytes),
+        router_type_(router_type),
+        stats_epoch_(0),
+        watchdog_interval_(100),
+        max_packet_age_(std::min(10000, simulation_time / 2)),
+        aborted_(false),
+        start_cycle_(0),
+        run_origin_(SC_ZERO_TIME),
+        checkpoint_at_(-1),
+        checkpoint_every_(0),
+        live_interval_(1000),
+        arbitration_name_("FIXED"),
+        arbitration_weights_(defaultArbiterWeights()),
+        faults_(mesh_size_x, mesh_size_y),
+        draining_(false),
+        clock_domains_(clock_domains) {
         
-        // Criar clock
+        // Criar clock de referência (e um gerador por domínio, se houver vários)
         clk = new sc_clock("clk", sc_time(1, SC_NS));
+        if (clock_domains_.isMultiClock()) {
+            create_clock_domains();
+        }
         
         // Criar routers e nós
         create_network();
         
-        // Registrar processo
-        SC_THREAD(run_simulation);
+        // Registrar processos (cada um refeito a cada execução após reset())
+        SC_THREAD(simulation_thread);
         sensitive << *clk;
+        
+        SC_THREAD(watchdog_thread);
+        
+        SC_THREAD(fault_injector_thread);
+        
+        SC_THREAD(checkpointer_thread);
+        
+        SC_THREAD(live_metrics_thread);
     }
     
     // Destrutor
@@ -40,6 +86,13 @@ public:
         delete clk;
     }
 
+    // Processos de uma execução, repetidos quando reset() inicia a próxima
+    void simulation_thread() { repeat_each_run(&NoC::run_simulation); }
+    void watchdog_thread() { repeat_each_run(&NoC::run_watchdog); }
+    void fault_injector_thread() { repeat_each_run(&NoC::run_fault_injector); }
+    void checkpointer_thread() { repeat_each_run(&NoC::run_checkpointer); }
+    void live_metrics_thread() { repeat_each_run(&NoC::run_live_metrics); }
+
     // Executar simulação
     void run_simulation() {
         std::cout << "Iniciando simulação NoC..." << std::endl;
@@ -47,16 +100,89 @@ public:
         std::cout << "Algoritmo de roteamento: " << routing_algorithm_name_ << std::endl;
         std::cout << "Taxa de injeção de pacotes: " << packet_injection_rate_ << "%" << std::endl;
         std::cout << "Tempo de simulação: " << simulation_time_ << " ciclos" << std::endl;
+        std::cout << "Enlaces: latência " << link_table_.getDefault().latency
+                  << " ciclos, largura " << link_table_.getDefault().width
+                  << " bytes, atraso de crédito " << link_table_.getDefault().credit_delay
+                  << " ciclos (" << channels_.size() << " canais em pipeline)" << std::endl;
+        if (!traffic_.packet_sizes.empty()) {
+            std::cout << "Tamanhos de pacote:";
+            for (const auto& size : traffic_.packet_sizes) {
+                std::cout << " " << size.first << " B (" << size.second << "%)";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Router: " << (router_type_ == "bufferless" ? "sem buffers (desvio)" : "com buffers")
+                  << ", arbitragem " << routers_.front()->getArbiterName() << std::endl;
+        if (traffic_.mode == TrafficConfig::REQUEST_REPLY) {
+            std::cout << "Tráfego: pedido-resposta, controladores de memória:";
+            for (int mc : traffic_.memory_controllers) {
+                std::cout << " " << mc;
+            }
+            std::cout << " (serviço " << traffic_.service_time << " ciclos, até "
+                      << traffic_.max_outstanding << " pedidos pendentes por nó)" << std::endl;
+        } else {
+            std::cout << "Tráfego: uniforme" << std::endl;
+        }
+        if (traffic_.multicast_rate > 0) {
+            std::cout << "Multicast: " << traffic_.multicast_rate << "% dos pacotes, ";
+            if (traffic_.multicast_fanout > 0) {
+                std::cout << traffic_.multicast_fanout << " destinos";
+            } else {
+                std::cout << "broadcast";
+            }
+            std::cout << (traffic_.multicast_as_unicast ? ", emulado por cópias unicast na origem" : ", replicado nos routers")
+                      << std::endl;
+        }
+        if (faults_.any() || !pending_faults_.empty()) {
+            std::cout << "Falhas: " << faults_.getNumFailedLinks() << " enlaces e "
+                      << faults_.getNumFailedRouters() << " routers desde o início, "
+                      << pending_faults_.size() << " agendadas";
+            if (up_down_table_) {
+                std::cout << "; tabelas up*/down* com raiz no router " << up_down_table_->getRoot();
+            }
+            std::cout << std::endl;
+        }
+        if (!domain_clocks_.empty()) {
+            std::cout << "Domínios de clock:";
+            for (const auto& domain_clock : domain_clocks_) {
+                std::cout << " " << domain_clock->getPeriod().to_seconds() * 1e9 << " ns";
+            }
+            std::cout << " (" << clock_domains_.dvfs_events.size() << " mudanças DVFS agendadas, "
+                      << crossings_.size() << " FIFOs de sincronização com " << clock_domains_.sync_stages
+                      << " estágios e profundidade " << clock_domains_.fifo_depth << ")" << std::endl;
+        }
+        if (start_cycle_ > 0) {
+            std::cout << "Checkpoint restaurado: continuando no ciclo " << start_cycle_
+                      << " (estatísticas a partir dele)" << std::endl;
+        }
         std::cout << "--------------------------------------------" << std::endl;
         
-        // Aguardar simulação completar
-        wait(simulation_time_ + 100, SC_NS);
+        // Aguardar simulação completar, amostrando contadores dos routers por época
+        int total_cycles = run_cycles();
+#ifdef NOC_ROUTER_STATS
+        if (stats_epoch_ > 0) {
+            stats_series_ = RouterStatsSeries(mesh_size_x_, mesh_size_y_, stats_epoch_);
+            stats_series_.setBaseline(collect_router_counters());
+            for (int cycle = stats_epoch_; cycle <= total_cycles; cycle += stats_epoch_) {
+                wait(stats_epoch_, SC_NS);
+                stats_series_.sample(start_cycle_ + cycle, collect_router_counters());
+            }
+            wait(total_cycles % stats_epoch_, SC_NS);
+        } else {
+            wait(total_cycles, SC_NS);
+        }
+#else
+        wait(total_cycles, SC_NS);
+#endif
         
         // Imprimir estatísticas
         print_statistics();
-        
-        // Terminar simulação
-        sc_stop();
+#ifdef NOC_ROUTER_STATS
+        print_router_statistics();
+        write_router_stats_series();
+#endif
+        close_trace();
+        publish_live_metrics(LiveMetricsSnapshot::RUN_FINISHED);
     }
 
     // Imprimir estatísticas da simulação
@@ -100,6 +226,864 @@ public:
                   << ", Total Received=" << total_packets_received
                   << ", Avg Latency=" << network_avg_latency
                   << ", Avg Hops=" << network_avg_hops << std::endl;
+        
+        long long bytes_sent = 0;
+        long long bytes_received = 0;
+        for (auto& node : nodes_) {
+            bytes_sent += node->getBytesSent();
+            bytes_received += node->getBytesReceived();
+        }
+        std::cout << "Bandwidth Summary:"
+                  << " Bytes Sent=" << bytes_sent
+                  << ", Bytes Received=" << bytes_received
+                  << ", Throughput=" << (measured_cycles() > 0 ? static_cast<double>(bytes_received) / measured_cycles() : 0.0) << " bytes/cycle"
+                  << ", Avg Packet Size=" << (total_packets_received > 0 ? static_cast<double>(bytes_received) / total_packets_received : 0.0)
+                  << " bytes" << std::endl;
+        
+        if (router_type_ == "bufferless") {
+            long long total_deflections = 0;
+            for (auto& node : nodes_) {
+                total_deflections += node->getTotalDeflections();
+            }
+            std::cout << "Deflection Summary:"
+                      << " Total Deflections=" << total_deflections
+                      << ", Avg Deflections=" << (total_packets_received > 0 ? static_cast<double>(total_deflections) / total_packets_received : 0.0)
+                      << ", Avg Hops=" << network_avg_hops << std::endl;
+        }
+        
+        print_class_statistics();
+        if (traffic_.mode == TrafficConfig::REQUEST_REPLY) {
+            print_request_reply_statistics();
+        }
+        if (traffic_.multicast_rate > 0) {
+            print_multicast_statistics();
+        }
+        if (!fault_phases_.empty()) {
+            print_fault_statistics();
+        }
+        if (!domain_clocks_.empty()) {
+            print_clock_domain_statistics(total_packets_received, network_avg_latency);
+        }
+        
+        // Conferir conservação: pacotes não entregues estão em trânsito ou se perderam
+        scoreboard_.finalize(collect_in_flight_ids());
+        scoreboard_.printReport(std::cout);
+    }
+
+    // Imprimir latência por classe de tráfego (média e percentis) das classes com pacotes
+    void print_class_statistics() {
+        for (int c = 0; c < Packet::NUM_TRAFFIC_CLASSES; c++) {
+            LatencyHistogram latency;
+            for (auto& node : nodes_) {
+                latency.merge(node->getClassLatency(c));
+            }
+            if (latency.getCount() == 0) {
+                continue;
+            }
+            
+            std::cout << "Traffic Class " << c << ":"
+                      << " Received=" << latency.getCount()
+                      << ", Avg Latency=" << latency.getMean()
+                      << ", P50 Latency=" << latency.getPercentile(50)
+                      << ", P99 Latency=" << latency.getPercentile(99)
+                      << ", Max Latency=" << latency.getMax() << std::endl;
+        }
+    }
+    
+    // Imprimir latência de ida e volta do tráfego pedido-resposta
+    void print_request_reply_statistics() {
+        int requests = 0;
+        int replies = 0;
+        int outstanding = 0;
+        long long total_round_trip = 0;
+        int max_round_trip = 0;
+        
+        for (auto& node : nodes_) {
+            if (node->isMemoryController()) {
+                std::cout << "Memory Controller " << node->getId() << ":"
+                          << " Served=" << node->getRequestsServed()
+                          << ", Pending Replies=" << node->getPendingReplies() << std::endl;
+                continue;
+            }
+            requests += node->getRequestsSent();
+            replies += node->getRepliesReceived();
+            outstanding += node->getOutstandingRequests();
+            total_round_trip += node->getTotalRoundTrip();
+            if (node->getMaxRoundTrip() > max_round_trip) {
+                max_round_trip = node->getMaxRoundTrip();
+            }
+        }
+        
+        std::cout << "Request/Reply Summary:"
+                  << " Requests=" << requests
+                  << ", Replies=" << replies
+                  << ", Outstanding=" << outstanding
+                  << ", Avg Round Trip=" << (replies > 0 ? static_cast<double>(total_round_trip) / replies : 0.0)
+                  << ", Max Round Trip=" << max_round_trip << std::endl;
+    }
+    
+    // Imprimir o custo do multicast: pacotes injetados por multicast, latência
+    // até cada destino e até o último destino de cada multicast
+    void print_multicast_statistics() {
+        long long multicasts = 0;
+        long long destinations = 0;
+        long long injections = 0;
+        LatencyHistogram latency;
+        LatencyHistogram completion;
+        for (auto& node : nodes_) {
+            multicasts += node->getMulticastsSent();
+            destinations += node->getMulticastDestinations();
+            injections += node->getMulticastInjections();
+            latency.merge(node->getMulticastLatency());
+            completion.merge(node->getMulticastCompletion());
+        }
+        
+        std::cout << "Multicast Summary:"
+                  << " Multicasts=" << multicasts
+                  << ", Destinations=" << destinations
+                  << ", Injected Packets=" << injections
+                  << ", Deliveries=" << latency.getCount()
+                  << ", Completed=" << completion.getCount() << std::endl;
+        std::cout << "Multicast Latency:"
+                  << " Avg Per-Destination=" << latency.getMean()
+                  << ", P99 Per-Destination=" << latency.getPercentile(99)
+                  << ", Avg Last-Arrival=" << completion.getMean()
+                  << ", P99 Last-Arrival=" << completion.getPercentile(99)
+                  << ", Max Last-Arrival=" << completion.getMax() << std::endl;
+    }
+    
+    // Vazão e latência em cada fase entre injeções de falha, até o fim da
+    // geração de pacotes, e a variação da última fase em relação à primeira
+    void print_fault_statistics() {
+        long long discarded = 0;
+        for (auto& router : routers_) {
+            discarded += router->getPacketsDiscarded();
+        }
+        std::cout << "Faults: Links Failed=" << faults_.getNumFailedLinks()
+                  << ", Routers Failed=" << faults_.getNumFailedRouters()
+                  << ", Live Nodes=" << live_nodes_.size()
+                  << ", Packets Discarded=" << discarded << std::endl;
+        
+        double first_throughput = 0;
+        double first_latency = 0;
+        double last_throughput = 0;
+        double last_latency = 0;
+        for (size_t k = 0; k + 1 < fault_phases_.size(); k++) {
+            const FaultPhase& begin = fault_phases_[k];
+            const FaultPhase& end = fault_phases_[k + 1];
+            int cycles = end.cycle - begin.cycle;
+            long long received = end.received - begin.received;
+            double throughput = cycles > 0 ? static_cast<double>(received) / cycles : 0.0;
+            double latency = received > 0 ? static_cast<double>(end.total_latency - begin.total_latency) / received : 0.0;
+            
+            std::cout << "Fault Phase " << k << " (cycles " << begin.cycle << "-" << end.cycle
+                      << ", " << begin.failed_links << " links/" << begin.failed_routers << " routers failed):"
+                      << " Received=" << received
+                      << ", Throughput=" << throughput << " packets/cycle"
+                      << ", Avg Latency=" << latency << std::endl;
+            
+            if (k == 0) {
+                first_throughput = throughput;
+                first_latency = latency;
+            }
+            last_throughput = throughput;
+            last_latency = latency;
+        }
+        
+        if (fault_phases_.size() > 2 && first_throughput > 0 && first_latency > 0) {
+            std::cout << "Fault Degradation: Throughput="
+                      << 100.0 * (last_throughput - first_throughput) / first_throughput << "%"
+                      << ", Avg Latency=" << 100.0 * (last_latency - first_latency) / first_latency << "%" << std::endl;
+        }
+    }
+    
+    // Imprimir desempenho por domínio de clock, em nanossegundos e em ciclos
+    // do próprio domínio (a latência dos nós é medida no clock de referência)
+    void print_clock_domain_statistics(int total_packets_received, double network_avg_latency) {
+        double reference_ns = clk->period().to_seconds() * 1e9;
+        double elapsed_ns = measured_cycles() * reference_ns;
+        std::cout << "Network Summary (ns): Simulated Time=" << elapsed_ns << " ns"
+                  << ", Avg Latency=" << network_avg_latency * reference_ns << " ns"
+                  << ", Throughput=" << (elapsed_ns > 0 ? total_packets_received / elapsed_ns : 0.0) << " packets/ns" << std::endl;
+        
+        for (int d = 0; d < clock_domains_.getNumDomains(); d++) {
+            int num_routers = 0;
+            int num_nodes = 0;
+            long long received = 0;
+            long long total_latency = 0;
+            for (int id = 0; id < static_cast<int>(nodes_.size()); id++) {
+                if (clock_domains_.routerDomain(id) == d) {
+                    num_routers++;
+                }
+                if (clock_domains_.nodeDomain(id) == d) {
+                    num_nodes++;
+                    received += nodes_[id]->getPacketsReceived();
+                    total_latency += nodes_[id]->getTotalLatency();
+                }
+            }
+            
+            const ClockGenerator& domain_clock = *domain_clocks_[d];
+            double avg_period_ns = domain_clock.getAveragePeriodNs();
+            double latency_ns = received > 0 ? static_cast<double>(total_latency) / received * reference_ns : 0.0;
+            std::cout << "Clock Domain " << d << ":"
+                      << " Period=" << domain_clock.getPeriod().to_seconds() * 1e9 << " ns"
+                      << ", Avg Period=" << avg_period_ns << " ns"
+                      << ", Cycles=" << domain_clock.getCycles()
+                      << ", Routers=" << num_routers
+                      << ", Nodes=" << num_nodes
+                      << ", Received=" << received
+                      << ", Avg Latency=" << latency_ns << " ns (" << latency_ns / avg_period_ns << " cycles)" << std::endl;
+        }
+    }
+    
+    // Configurar falhas (antes de iniciar a simulação): as do ciclo 0 são
+    // aplicadas já, as demais pelo injetor durante a simulação
+    void setFaults(const FaultSchedule& schedule) {
+        bool applied = false;
+        for (const FaultEvent& event : schedule.getEvents()) {
+            if (event.cycle == 0 || event.cycle < start_cycle_) {
+                applied |= apply_fault(event);
+            } else if (event.cycle < simulation_time_) {
+                pending_faults_.push_back(event);
+            }
+        }
+        if (applied) {
+            update_routing();
+        }
+    }
+    
+    // Injetor de falhas: aplica as falhas agendadas no ciclo indicado, recalcula
+    // as tabelas up*/down* sem reiniciar a simulação e registra o início de cada
+    // fase para medir a degradação. Com routers com buffers, as tabelas só são
+    // trocadas depois que a rede esvazia: os nós suspendem a injeção e os
+    // pacotes em trânsito terminam pelas rotas antigas (ou são descartados se
+    // elas usam um enlace rompido), pois pacotes seguindo rotas antigas e novas
+    // ao mesmo tempo podem fechar um ciclo de dependências entre buffers
+    void run_fault_injector() {
+        if (!faults_.any() && pending_faults_.empty()) {
+            return;
+        }
+        
+        // As fases começam no ciclo restaurado, junto com as estatísticas dos nós
+        int cycle = start_cycle_;
+        record_fault_phase(cycle);
+        size_t next = 0;
+        while (next < pending_faults_.size()) {
+            if (pending_faults_[next].cycle > cycle) {
+                wait(pending_faults_[next].cycle - cycle, SC_NS);
+                cycle = pending_faults_[next].cycle;
+            }
+            
+            std::ostringstream applied;
+            if (!apply_pending_faults(next, cycle, applied)) {
+                continue;
+            }
+            int fault_cycle = cycle;
+            
+            int drain_cycles = -1;
+            if (up_down_table_ && router_type_ != "bufferless") {
+                set_draining(true);
+                int last_cycle = simulation_time_ + 100;
+                while (!network_empty() && cycle < last_cycle) {
+                    wait(1, SC_NS);
+                    cycle++;
+                    std::ostringstream during;
+                    if (apply_pending_faults(next, cycle, during)) {
+                        applied << ", " << during.str() << " at cycle " << cycle;
+                    }
+                }
+                set_draining(false);
+                drain_cycles = cycle - fault_cycle;
+            }
+            update_routing();
+            
+            std::cout << "Fault injected at cycle " << fault_cycle << ": " << applied.str();
+            if (drain_cycles >= 0) {
+                std::cout << " (network drained in " << drain_cycles << " cycles)";
+            }
+            if (up_down_table_) {
+                std::string report;
+                UpDownRoutingAlgorithm routing(up_down_table_, mesh_size_x_);
+                bool acyclic = checkRoutingDeadlockFreedom(routing, mesh_size_x_, mesh_size_y_, report,
+                                                           live_routers_);
+                std::cout << " (up*/down* tables recomputed, root " << up_down_table_->getRoot()
+                          << ", " << (acyclic ? "deadlock-free" : report) << ")";
+            }
+            std::cout << std::endl;
+        }
+        
+        // Fechar a última fase no fim da geração de pacotes
+        wait(std::max(simulation_time_ - cycle, 0), SC_NS);
+        record_fault_phase(simulation_time_);
+    }
+    
+    // Configurar a política de arbitragem de todos os routers (antes de iniciar a simulação)
+    void setArbitration(const std::string& arbitration_name, const std::vector<int>& weights) {
+        arbitration_name_ = arbitration_name;
+        arbitration_weights_ = weights;
+        for (auto& router : routers_) {
+            router->setArbiter(createArbiter(arbitration_name, Router::NUM_OUTPUT_SLOTS, weights));
+        }
+    }
+    
+    // Configurar o modo de tráfego de todos os nós (antes de iniciar a simulação)
+    void setTraffic(const TrafficConfig& traffic) {
+        traffic_ = traffic;
+        for (auto& node : nodes_) {
+            node->setTraffic(traffic);
+        }
+    }
+    
+    // Gravar o trace binário de eventos dos pacotes em filename, limitado pelo
+    // filtro; o ciclo de cada evento é o mesmo tempo dos nós (latências)
+    bool setTrace(const std::string& filename, const TraceFilter& filter, std::string& error) {
+        trace_.reset(new EventTraceWriter(filename, mesh_size_x_, mesh_size_y_, filter,
+                                          [this] { return static_cast<long long>(current_cycle()) + 1; }));
+        if (!trace_->ok()) {
+            trace_.reset();
+            error = "não foi possível criar " + filename;
+            return false;
+        }
+        trace_file_ = filename;
+        for (auto& router : routers_) {
+            router->setTrace(trace_.get());
+        }
+        for (auto& node : nodes_) {
+            node->setTrace(trace_.get());
+        }
+        return true;
+    }
+    
+    // Configurar amostragem dos contadores dos routers a cada epoch_cycles ciclos,
+    // gravando output_prefix.csv e output_prefix.json ao final (requer NOC_ROUTER_STATS)
+    void setStatsEpoch(int epoch_cycles, const std::string& output_prefix) {
+        stats_epoch_ = epoch_cycles;
+        stats_output_prefix_ = output_prefix;
+    }
+
+#ifdef NOC_ROUTER_STATS
+    // Imprimir contadores acumulados por router (ocupação média, bloqueios, perdas, utilização)
+    void print_router_statistics() {
+        std::vector<RouterCounters> counters = collect_router_counters();
+        
+        std::cout << "\n-------- Router Statistics --------" << std::endl;
+        for (size_t r = 0; r < counters.size(); r++) {
+            double avg_occupancy = 0;
+            uint64_t blocked = 0;
+            uint64_t losses = 0;
+            uint64_t busy = 0;
+            for (int p = 0; p < RouterCounters::NUM_PORTS; p++) {
+                const PortCounters& port = counters[r].ports[p];
+                avg_occupancy += counters[r].cycles > 0 ? static_cast<double>(port.occupancy_sum) / counters[r].cycles : 0.0;
+                blocked += port.blocked_cycles;
+                losses += port.arbitration_losses;
+                busy += port.link_busy_cycles;
+            }
+            
+            std::cout << "Router " << r << ":"
+                      << " Avg Occupancy=" << avg_occupancy
+                      << ", Blocked Cycles=" << blocked
+                      << ", Arbitration Losses=" << losses
+                      << ", Packets Forwarded=" << routers_[r]->getPacketsForwarded()
+                      << ", Link Busy Cycles=" << busy << std::endl;
+        }
+    }
+#endif
+
+    // Configurar o watchdog: verificação a cada check_interval ciclos (0 = desligado)
+    // e tempo de um pacote parado na cabeça de uma fila até avisar (0 = sem aviso)
+    void setWatchdog(int check_interval, int max_packet_age) {
+        watchdog_interval_ = check_interval;
+        max_packet_age_ = max_packet_age;
+    }
+    
+    // Indica se a simulação foi abortada pelo watchdog
+    bool wasAborted() const { return aborted_; }
+    
+    // Métricas da execução terminada, na ordem de RunResult::metricNames()
+    std::vector<double> getRunMetrics() const {
+        long long sent = 0;
+        long long received = 0;
+        long long deflections = 0;
+        long long bytes = 0;
+        double total_latency = 0;
+        double total_hops = 0;
+        LatencyHistogram latency;
+        for (const auto& node : nodes_) {
+            sent += node->getPacketsSent();
+            received += node->getPacketsReceived();
+            deflections += node->getTotalDeflections();
+            bytes += node->getBytesReceived();
+            total_latency += node->getAverageLatency() * node->getPacketsReceived();
+            total_hops += node->getAverageHops() * node->getPacketsReceived();
+            for (int c = 0; c < Packet::NUM_TRAFFIC_CLASSES; c++) {
+                latency.merge(node->getClassLatency(c));
+            }
+        }
+        // Entregas esperadas: um multicast conta uma vez por destino
+        long long expected = scoreboard_.getInjected();
+        
+        return {
+            static_cast<double>(sent),
+            static_cast<double>(received),
+            measured_cycles() > 0 ? static_cast<double>(received) / measured_cycles() : 0.0,
+            expected > 0 ? 100.0 * received / expected : 0.0,
+            received > 0 ? total_latency / received : 0.0,
+            static_cast<double>(latency.getPercentile(50)),
+            static_cast<double>(latency.getPercentile(95)),
+            static_cast<double>(latency.getPercentile(99)),
+            static_cast<double>(latency.getMax()),
+            received > 0 ? total_hops / received : 0.0,
+            static_cast<double>(deflections),
+            static_cast<double>(scoreboard_.getLost()),
+            measured_cycles() > 0 ? static_cast<double>(bytes) / measured_cycles() : 0.0
+        };
+    }
+    
+    // Watchdog de deadlock/livelock: a cada intervalo acompanha o pacote na
+    // cabeça de cada fila (buffers dos routers, saídas dos canais e FIFOs entre
+    // domínios) e procura um ciclo no grafo de espera entre buffers cheios cujas
+    // cabeças não se moveram desde a verificação anterior, o que pega deadlocks
+    // parciais enquanto o resto da rede progride. Aborta também se nada se mover
+    // em um intervalo; um pacote parado na cabeça de uma fila por mais de
+    // max_packet_age_ ciclos com a rede progredindo (inanição, não bloqueio)
+    // só gera um aviso
+    void run_watchdog() {
+        if (watchdog_interval_ <= 0) {
+            return;
+        }
+        
+        std::vector<HeadWait> head_waits((routers_.size() * 5 + channels_.size() + crossings_.size()) *
+                                         Packet::NUM_MESSAGE_CLASSES, HeadWait{-1, 0});
+        
+        // A última verificação acontece antes do fim da execução
+        long long last_progress = -1;
+        long long warned_packet = -1;
+        int total_cycles = run_cycles();
+        for (int elapsed = watchdog_interval_; elapsed < total_cycles; elapsed += watchdog_interval_) {
+            wait(watchdog_interval_, SC_NS);
+            int cycle = current_cycle();
+            
+            long long progress = 0;
+            bool moved = false;
+            size_t index = 0;
+            for (const auto& router : routers_) {
+                progress += router->getPacketsForwarded();
+                for (int port = 0; port < 5; port++) {
+                    for (int c = 0; c < Packet::NUM_MESSAGE_CLASSES; c++) {
+                        moved |= track_head(head_waits[index++], router->getHeadPacket(port, c), cycle);
+                    }
+                }
+            }
+            for (const auto& channel : channels_) {
+                moved |= channel->hasPacketInTransit();
+                for (int c = 0; c < Packet::NUM_MESSAGE_CLASSES; c++) {
+                    moved |= track_head(head_waits[index++], channel->getHeadPacket(c), cycle);
+                }
+            }
+            for (const auto& crossing : crossings_) {
+                moved |= crossing->hasPacketInTransit();
+                for (int c = 0; c < Packet::NUM_MESSAGE_CLASSES; c++) {
+                    moved |= track_head(head_waits[index++], crossing->getHeadPacket(c), cycle);
+                }
+            }
+            
+            // Pacote parado há mais tempo na cabeça de uma fila
+            int stalled = -1;
+            for (size_t i = 0; i < head_waits.size(); i++) {
+                if (head_waits[i].packet_id >= 0 && (stalled < 0 || head_waits[i].since < head_waits[stalled].since)) {
+                    stalled = static_cast<int>(i);
+                }
+            }
+            
+            std::ostringstream reason;
+            std::vector<PortId> blocked_cycle;
+            bool cyclic = find_wait_for_cycle(head_waits, cycle, blocked_cycle);
+            if (cyclic) {
+                reason << "cyclic wait among " << blocked_cycle.size() << " full buffers whose heads have not moved in "
+                       << watchdog_interval_ << " cycles";
+            } else if (stalled >= 0 && !moved && progress == last_progress) {
+                reason << "no packet moved in the last " << watchdog_interval_ << " cycles";
+            } else if (stalled >= 0 && max_packet_age_ > 0 && cycle - head_waits[stalled].since > max_packet_age_ &&
+                       head_waits[stalled].packet_id != warned_packet) {
+                warned_packet = head_waits[stalled].packet_id;
+                std::cout << "Watchdog warning at cycle " << cycle << ": packet " << warned_packet << " stuck at "
+                          << head_wait_name(stalled) << " for " << cycle - head_waits[stalled].since
+                          << " cycles (limit " << max_packet_age_ << "), network still progressing" << std::endl;
+            }
+            last_progress = progress;
+            
+            if (reason.str().empty()) {
+                continue;
+            }
+            
+            std::cout << "\n-------- Watchdog --------" << std::endl;
+            std::cout << "Simulation aborted at cycle " << cycle << ": " << reason.str() << std::endl;
+            
+            if (cyclic) {
+                std::cout << "Deadlock cycle: " << PortGraph::describe(blocked_cycle) << std::endl;
+                for (const PortId& id : blocked_cycle) {
+                    const BaseRouter& router = *routers_[id.router];
+                    const Packet* head = router.getHeadPacket(id.port, id.message_class);
+                    std::cout << "  " << PortGraph::name(id)
+                              << " occupancy=" << router.getBufferOccupancy(id.port, id.message_class)
+                              << " waits for " << directionName(router.getHeadOutputPort(id.port, id.message_class))
+                              << " head=" << *head << std::endl;
+                }
+            } else {
+                std::cout << "No cyclic wait found (livelock or starvation)" << std::endl;
+            }
+            
+            aborted_ = true;
+            print_statistics();
+            close_trace();
+            publish_live_metrics(LiveMetricsSnapshot::ABORTED);
+            sc_stop();
+            return;
+        }
+    }
+    
+    // Gravar checkpoints em filename no ciclo at_cycle (-1 = nenhum) e a cada
+    // every_cycles ciclos (0 = nenhum); cada gravação substitui a anterior
+    void setCheckpoint(const std::string& filename, int at_cycle, int every_cycles) {
+        checkpoint_file_ = filename;
+        checkpoint_at_ = at_cycle;
+        checkpoint_every_ = every_cycles;
+    }
+    
+    // Gravador de checkpoints: acorda meio ciclo após a borda de subida, quando
+    // todos os processos do ciclo já rodaram e os sinais estão estáveis
+    void run_checkpointer() {
+        if (checkpoint_file_.empty()) {
+            return;
+        }
+        
+        int last_cycle = simulation_time_ + 100;
+        std::vector<int> cycles;
+        if (checkpoint_at_ >= start_cycle_ && checkpoint_at_ < last_cycle) {
+            cycles.push_back(checkpoint_at_);
+        }
+        if (checkpoint_every_ > 0) {
+            for (int cycle = (start_cycle_ / checkpoint_every_ + 1) * checkpoint_every_; cycle < last_cycle;
+                 cycle += checkpoint_every_) {
+                cycles.push_back(cycle);
+            }
+        }
+        std::sort(cycles.begin(), cycles.end());
+        cycles.erase(std::unique(cycles.begin(), cycles.end()), cycles.end());
+        
+        for (int cycle : cycles) {
+            sc_time when = run_origin_ + clk->period() * (cycle - start_cycle_) + clk->period() / 2;
+            if (when < sc_time_stamp()) {
+                continue;
+            }
+            wait(when - sc_time_stamp());
+            
+            // Com a rede esvaziando para trocar as tabelas, os pacotes seguem as
+            // rotas antigas: gravar só depois da troca
+            while (draining_ && cycle < last_cycle) {
+                wait(clk->period());
+                cycle++;
+            }
+            
+            std::string error;
+            if (saveCheckpoint(checkpoint_file_, cycle, error)) {
+                std::cout << "Checkpoint written at cycle " << cycle << ": " << checkpoint_file_ << std::endl;
+            } else {
+                std::cout << "Error: could not write checkpoint at cycle " << cycle << ": " << error << std::endl;
+            }
+        }
+    }
+    
+    // Publicar métricas ao vivo no segmento de memória compartilhada name a
+    // cada interval ciclos (ver tools/live_monitor). O segmento vale para
+    // todas as execuções seguintes e é removido com a rede.
+    bool setLiveMetrics(const std::string& name, int interval, std::string& error) {
+        std::unique_ptr<LiveMetricsPublisher> publisher(new LiveMetricsPublisher());
+        if (!publisher->open(name, error)) {
+            return false;
+        }
+        live_ = std::move(publisher);
+        live_interval_ = interval;
+        return true;
+    }
+    
+    // Publicador das métricas ao vivo: como o gravador de checkpoints, acorda
+    // meio ciclo após a borda, a cada live_interval_ ciclos; a publicação só
+    // copia contadores para o segmento e nunca espera pelo leitor
+    void run_live_metrics() {
+        if (!live_) {
+            return;
+        }
+        
+        live_->beginRun(start_cycle_);
+        publish_live_metrics(LiveMetricsSnapshot::RUNNING);
+        int last_cycle = simulation_time_ + 100;
+        for (int cycle = (start_cycle_ / live_interval_ + 1) * live_interval_; cycle < last_cycle;
+             cycle += live_interval_) {
+            sc_time when = run_origin_ + clk->period() * (cycle - start_cycle_) + clk->period() / 2;
+            wait(when - sc_time_stamp());
+            publish_live_metrics(LiveMetricsSnapshot::RUNNING);
+        }
+    }
+    
+    // Gravar o estado completo da rede após a borda do ciclo cycle: routers,
+    // nós, enlaces, valores de todos os sinais, scoreboard e fases de falha.
+    // O arquivo é escrito ao lado e renomeado, então um processo interrompido
+    // nunca deixa um checkpoint pela metade.
+    bool saveCheckpoint(const std::string& filename, int cycle, std::string& error) const {
+        if (!domain_clocks_.empty()) {
+            error = "checkpoints exigem um único domínio de clock";
+            return false;
+        }
+        
+        std::string temporary = filename + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary);
+            if (!file) {
+                error = "não foi possível criar " + temporary;
+                return false;
+            }
+            CheckpointWriter out(file);
+            write_checkpoint_header(out);
+            out.writeInt(cycle);
+            
+            scoreboard_.saveState(out);
+            out.writeUnsigned(fault_phases_.size());
+            for (const FaultPhase& phase : fault_phases_) {
+                out.writeInt(phase.cycle);
+                out.writeInt(phase.received);
+                out.writeInt(phase.total_latency);
+                out.writeInt(phase.failed_links);
+                out.writeInt(phase.failed_routers);
+            }
+            
+            for (const auto& router : routers_) {
+                router->saveState(out);
+            }
+            for (const auto& node : nodes_) {
+                node->saveState(out);
+            }
+            for (const auto& channel : channels_) {
+                channel->saveState(out);
+            }
+            for (const auto& signal : packet_signals_) {
+                signal->read().saveState(out);
+            }
+            for (const auto& signal : valid_signals_) {
+                out.writeBool(signal->read());
+            }
+            for (const auto& signal : ready_signals_) {
+                out.writeInt(signal->read());
+            }
+            
+            if (!out.ok()) {
+                error = "falha ao gravar " + temporary;
+                return false;
+            }
+        }
+        if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            error = "não foi possível renomear " + temporary;
+            return false;
+        }
+        return true;
+    }
+    
+    // Restaurar um checkpoint antes de iniciar a simulação; a simulação
+    // continua no ciclo seguinte ao gravado. A rede deve ter a mesma estrutura
+    // (malha, tipo de router, enlaces); taxa de injeção, tráfego, roteamento e
+    // arbitragem podem mudar, o que permite vários experimentos a partir de um
+    // mesmo aquecimento. As estatísticas (contadores dos nós e routers,
+    // histogramas, scoreboard e fases de falha) recomeçam no ciclo restaurado,
+    // e só o estado da rede continua. Falhas não são gravadas: passe o mesmo
+    // agendamento, com setFaults chamado depois desta função.
+    bool loadCheckpoint(const std::string& filename, std::string& error) {
+        if (!domain_clocks_.empty()) {
+            error = "checkpoints exigem um único domínio de clock";
+            return false;
+        }
+        
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            error = "não foi possível abrir " + filename;
+            return false;
+        }
+        CheckpointReader in(file);
+        if (!read_checkpoint_header(in, error)) {
+            return false;
+        }
+        int cycle = static_cast<int>(in.readInt());
+        
+        scoreboard_.loadState(in);
+        fault_phases_.assign(in.readSize(), FaultPhase());
+        for (FaultPhase& phase : fault_phases_) {
+            phase.cycle = static_cast<int>(in.readInt());
+            phase.received = in.readInt();
+            phase.total_latency = in.readInt();
+            phase.failed_links = static_cast<int>(in.readInt());
+            phase.failed_routers = static_cast<int>(in.readInt());
+        }
+        
+        for (auto& router : routers_) {
+            router->loadState(in);
+        }
+        for (auto& node : nodes_) {
+            node->loadState(in);
+        }
+        for (auto& channel : channels_) {
+            channel->loadState(in);
+        }
+        
+        // Sinais escritos antes de sc_start valem desde o primeiro ciclo
+        for (auto& signal : packet_signals_) {
+            Packet packet;
+            packet.loadState(in);
+            signal->write(packet);
+        }
+        for (auto& signal : valid_signals_) {
+            signal->write(in.readBool());
+        }
+        for (auto& signal : ready_signals_) {
+            signal->write(static_cast<int>(in.readInt()));
+        }
+        
+        if (!in.ok() || cycle < 0 || file.peek() != std::char_traits<char>::eof()) {
+            error = filename + ": arquivo corrompido ou de outra versão";
+            return false;
+        }
+        
+        // Medir só o que a execução restaurada simula: as entregas pendentes
+        // do aquecimento passam a ser as injetadas do scoreboard
+        scoreboard_.resetCounts();
+        fault_phases_.clear();
+        for (auto& router : routers_) {
+            router->resetStatistics();
+        }
+        for (auto& node : nodes_) {
+            node->resetStatistics();
+        }
+        start_cycle_ = cycle + 1;
+        return true;
+    }
+    
+    // Reiniciar a rede já construída para uma nova execução, com a simulação
+    // parada entre duas chamadas de sc_start: esvazia routers, enlaces e FIFOs,
+    // zera nós, scoreboard, falhas e sinais, e recomeça o tempo na próxima
+    // borda de subida do clock. A estrutura (malha, routers, enlaces e
+    // domínios de clock) é mantida; roteamento, taxa, tempo, semente, tráfego,
+    // arbitragem, falhas e checkpoints são configurados de novo em seguida.
+    void reset() {
+        sc_time period = clk->period();
+        run_origin_ = period * std::ceil(sc_time_stamp() / period);
+        start_cycle_ = 0;
+        aborted_ = false;
+        setCheckpoint("", -1, 0);
+        close_trace();
+        
+        scoreboard_ = PacketScoreboard();
+        faults_ = MeshFaults(mesh_size_x_, mesh_size_y_);
+        pending_faults_.clear();
+        live_nodes_.clear();
+        live_routers_.clear();
+        draining_ = false;
+        fault_phases_.clear();
+        if (up_down_table_) {
+            up_down_table_->rebuild(faults_);
+        }
+        
+        for (auto& router : routers_) {
+            router->reset();
+        }
+        setArbitration(arbitration_name_, arbitration_weights_);
+        for (auto& node : nodes_) {
+            node->reset(run_origin_);
+        }
+        for (auto& channel : channels_) {
+            channel->reset();
+        }
+        for (auto& crossing : crossings_) {
+            crossing->reset();
+        }
+        for (auto& domain_clock : domain_clocks_) {
+            domain_clock->restart(run_origin_);
+        }
+        
+        // Sinais voltam aos valores iniciais antes da primeira borda
+        for (auto& signal : packet_signals_) {
+            signal->write(Packet());
+        }
+        for (auto& signal : valid_signals_) {
+            signal->write(false);
+        }
+        for (auto& signal : ready_signals_) {
+            signal->write(0);
+        }
+        
+        run_started_.notify(run_origin_ - sc_time_stamp());
+    }
+    
+    // Trocar o algoritmo de roteamento de todos os routers (antes de iniciar
+    // uma execução e de configurar as falhas)
+    void setRoutingAlgorithm(const std::string& routing_algorithm_name) {
+        routing_algorithm_name_ = routing_algorithm_name;
+        up_down_table_.reset();
+        for (auto& router : routers_) {
+            router->setRoutingAlgorithm(create_routing_algorithm());
+        }
+    }
+    
+    // Configurar taxa de injeção e tempo de geração de pacotes de todos os nós
+    void setInjectionRate(int packet_injection_rate) {
+        packet_injection_rate_ = packet_injection_rate;
+        for (auto& node : nodes_) {
+            node->setInjectionRate(packet_injection_rate);
+        }
+    }
+    
+    void setSimulationTime(int simulation_time) {
+        simulation_time_ = simulation_time;
+        for (auto& node : nodes_) {
+            node->setSimulationTime(simulation_time);
+        }
+    }
+    
+    // Semear os geradores aleatórios dos nós: com a mesma semente e a mesma
+    // configuração, a execução se repete exatamente
+    void setSeed(unsigned seed) {
+        for (auto& node : nodes_) {
+            node->setSeed(seed);
+        }
+    }
+    
+    // Duração a passar para sc_start: até o fim da execução configurada e
+    // mais meio ciclo, quando todos os seus processos já terminaram
+    sc_time getRunDuration() const {
+        return run_origin_ - sc_time_stamp() + clk->period() * run_cycles() + clk->period() / 2;
+    }
+    
+    // Ciclo em que a simulação começou (0, ou o seguinte ao checkpoint restaurado)
+    int getStartCycle() const { return start_cycle_; }
+    
+    // Obter o scoreboard de pacotes da rede
+    const PacketScoreboard& getScoreboard() const { return scoreboard_; }
+    
+    // Obter totais agregados da rede
+    int getNumRouters() const { return static_cast<int>(routers_.size()); }
+    
+    int getTotalPacketsSent() const {
+        int total = 0;
+        for (const auto& node : nodes_) {
+            total += node->getPacketsSent();
+        }
+        return total;
+    }
+    
+    int getTotalPacketsReceived() const {
+        int total = 0;
+        for (const auto& node : nodes_) {
+            total += node->getPacketsReceived();
+        }
+        return total;
     }
 
 private:
@@ -107,41 +1091,548 @@ private:
     int packet_injection_rate_;               // Taxa de injeção (porcentagem)
     int simulation_time_;                     // Tempo de simulação em ciclos
     std::string routing_algorithm_name_;      // Nome do algoritmo de roteamento
+    LinkTable link_table_;                    // Latência, largura e crédito de cada enlace
+    int max_packet_bytes_;                    // Maior pacote gerado (enlaces diretos o transferem em 1 ciclo)
+    std::string router_type_;                 // "buffered" (Router) ou "bufferless" (DeflectionRouter)
+    int stats_epoch_;                         // Período de amostragem dos contadores (0 = desligado)
+    std::string stats_output_prefix_;         // Prefixo dos arquivos de série temporal
+    int watchdog_interval_;                   // Período de verificação do watchdog (0 = desligado)
+    int max_packet_age_;                      // Ciclos de um pacote parado na cabeça de uma fila até o aviso
+    bool aborted_;                            // Simulação abortada pelo watchdog
+    int start_cycle_;                         // Ciclo do primeiro clock (após restaurar um checkpoint)
+    sc_time run_origin_;                      // Instante da primeira borda da execução atual
+    sc_event run_started_;                    // Início de uma nova execução após reset()
+    std::string checkpoint_file_;             // Arquivo de checkpoint a gravar (vazio = nenhum)
+    int checkpoint_at_;                       // Ciclo do checkpoint único (-1 = nenhum)
+    int checkpoint_every_;                    // Período dos checkpoints periódicos (0 = desligado)
+    int live_interval_;                       // Período das publicações ao vivo em ciclos
+    std::string arbitration_name_;            // Política de arbitragem dos routers
+    std::vector<int> arbitration_weights_;    // Pesos da política WRR
+    PacketScoreboard scoreboard_;             // IDs e conferência fim-a-fim dos pacotes
+    TrafficConfig traffic_;                   // Modo de tráfego dos nós
+    
+    // Falhas: estado atual, tabelas up*/down* compartilhadas pelos routers
+    // (apenas com roteamento UP_DOWN) e falhas ainda por injetar
+    MeshFaults faults_;
+    std::shared_ptr<UpDownRoutingTable> up_down_table_;
+    std::vector<FaultEvent> pending_faults_;
+    std::vector<int> live_nodes_;             // Nós ativos, destinos válidos do tráfego
+    std::vector<bool> live_routers_;          // Routers vivos e alcançáveis
+    bool draining_;                           // Rede esvaziando antes da troca das tabelas
+    
+    // Trace de eventos da execução (nulo = desligado)
+    std::unique_ptr<EventTraceWriter> trace_;
+    std::string trace_file_;
+    
+    // Fechar o trace e desligá-lo nos routers e nós
+    void close_trace() {
+        if (!trace_) {
+            return;
+        }
+        long long bytes = trace_->getBytes();
+        trace_->close();
+        std::cout << "Event trace written to " << trace_file_ << ": " << trace_->getEvents() << " events, "
+                  << bytes << " bytes" << std::endl;
+        for (auto& router : routers_) {
+            router->setTrace(nullptr);
+        }
+        for (auto& node : nodes_) {
+            node->setTrace(nullptr);
+        }
+        trace_.reset();
+    }
+    
+    // Métricas ao vivo do processo (nulo = desligado)
+    std::unique_ptr<LiveMetricsPublisher> live_;
+    
+    // Publicar o estado atual: contadores dos nós e do scoreboard, histograma
+    // de latências de todas as classes e ocupação dos buffers de cada router
+    void publish_live_metrics(LiveMetricsSnapshot::State state) {
+        if (!live_) {
+            return;
+        }
+        LiveMetricsSnapshot& snapshot = live_->next();
+        snapshot.mesh_size_x = mesh_size_x_;
+        snapshot.mesh_size_y = mesh_size_y_;
+        snapshot.state = state;
+        snapshot.cycle = std::min(current_cycle(), simulation_time_ + 100);
+        snapshot.last_cycle = simulation_time_ + 100;
+        snapshot.generation_end = simulation_time_;
+        
+        for (const auto& node : nodes_) {
+            snapshot.sent += node->getPacketsSent();
+            snapshot.received += node->getPacketsReceived();
+            // Carga oferecida só no tráfego uniforme; pedido-resposta é limitado pelas respostas
+            if (traffic_.mode == TrafficConfig::UNIFORM && node->isEnabled()) {
+                snapshot.offered_load += packet_injection_rate_ / 100.0;
+            }
+            for (int c = 0; c < Packet::NUM_TRAFFIC_CLASSES; c++) {
+                const LatencyHistogram& latency = node->getClassLatency(c);
+                if (latency.getCount() == 0) {
+                    continue;
+                }
+                for (int l = 0; l <= latency.getMax(); l++) {
+                    uint64_t count = latency.getBin(l);
+                    if (l < LiveMetricsSnapshot::LATENCY_BINS) {
+                        snapshot.latency_bins[l] += count;
+                    } else {
+                        snapshot.latency_overflow += count;
+                    }
+                    snapshot.latency_sum += count * static_cast<uint64_t>(l);
+                }
+                snapshot.latency_count += latency.getCount();
+                snapshot.latency_max = std::max<int64_t>(snapshot.latency_max, latency.getMax());
+            }
+        }
+        snapshot.lost = scoreboard_.getLost();
+        snapshot.in_flight = std::max(scoreboard_.getInjected() - scoreboard_.getDelivered() - scoreboard_.getLost(), 0LL);
+        
+        int num_routers = std::min(static_cast<int>(routers_.size()), LiveMetricsSnapshot::MAX_ROUTERS);
+        for (int r = 0; r < num_routers; r++) {
+            for (int port = 0; port < 5; port++) {
+                for (int m = 0; m < Packet::NUM_MESSAGE_CLASSES; m++) {
+                    snapshot.occupancy[r] += routers_[r]->getBufferOccupancy(port, m);
+                }
+            }
+        }
+        live_->publish();
+    }
+    
+    // Totais da rede no início de uma fase entre falhas
+    struct FaultPhase {
+        int cycle;
+        long long received;
+        long long total_latency;
+        int failed_links;
+        int failed_routers;
+    };
+    std::vector<FaultPhase> fault_phases_;
+    
+    void record_fault_phase(int cycle) {
+        FaultPhase phase;
+        phase.cycle = cycle;
+        phase.received = 0;
+        phase.total_latency = 0;
+        for (const auto& node : nodes_) {
+            phase.received += node->getPacketsReceived();
+            phase.total_latency += node->getTotalLatency();
+        }
+        phase.failed_links = faults_.getNumFailedLinks();
+        phase.failed_routers = faults_.getNumFailedRouters();
+        fault_phases_.push_back(phase);
+    }
+    
+    // Ciclo atual do clock de referência na execução, contando os anteriores ao checkpoint
+    int current_cycle() const {
+        return static_cast<int>((sc_time_stamp() - run_origin_) / clk->period()) + start_cycle_;
+    }
+    
+    // Ciclos simulados pela execução: geração de pacotes e 100 ciclos de escoamento
+    int run_cycles() const {
+        return std::max(simulation_time_ + 100 - start_cycle_, 0);
+    }
+    
+    // Ciclos de geração medidos (vazão): só os posteriores ao checkpoint restaurado
+    int measured_cycles() const {
+        return std::max(simulation_time_ - start_cycle_, 0);
+    }
+    
+    // Rodar um processo a cada execução: a primeira começa com a simulação e
+    // as seguintes quando reset() notifica run_started_ na sua primeira borda
+    void repeat_each_run(void (NoC::*run)()) {
+        while (true) {
+            (this->*run)();
+            wait(run_started_);
+        }
+    }
+    
+    // Cabeçalho do checkpoint: formato e estrutura da rede, conferidos na
+    // restauração antes de qualquer estado
+    static constexpr const char* CHECKPOINT_MAGIC = "SimpleNoC checkpoint";
+    static const int CHECKPOINT_VERSION = 5;
+    
+    void write_checkpoint_header(CheckpointWriter& out) const {
+        out.writeString(CHECKPOINT_MAGIC);
+        out.writeInt(CHECKPOINT_VERSION);
+        out.writeInts(checkpoint_structure());
+        out.writeString(router_type_);
+    }
+    
+    bool read_checkpoint_header(CheckpointReader& in, std::string& error) const {
+        if (in.readString() != CHECKPOINT_MAGIC || in.readInt() != CHECKPOINT_VERSION) {
+            error = "não é um checkpoint desta versão do simulador";
+            return false;
+        }
+        std::vector<int> structure = in.readInts();
+        std::string router_type = in.readString();
+        if (!in.ok() || structure != checkpoint_structure() || router_type != router_type_) {
+            error = "checkpoint de outra rede (tamanho da malha, tipo de router ou enlaces diferentes)";
+            return false;
+        }
+        return true;
+    }
+    
+    // Dimensões e quantidade de componentes e sinais, na ordem de criação
+    std::vector<int> checkpoint_structure() const {
+        return std::vector<int>{mesh_size_x_, mesh_size_y_, static_cast<int>(channels_.size()),
+                                static_cast<int>(packet_signals_.size()), static_cast<int>(valid_signals_.size()),
+                                static_cast<int>(ready_signals_.size())};
+    }
+    
+    // Aplicar as falhas agendadas até cycle, a partir de next, listando-as em
+    // applied e abrindo uma fase de degradação; indica se alguma era nova
+    bool apply_pending_faults(size_t& next, int cycle, std::ostringstream& applied) {
+        bool any = false;
+        for (; next < pending_faults_.size() && pending_faults_[next].cycle <= cycle; next++) {
+            if (apply_fault(pending_faults_[next])) {
+                applied << (applied.str().empty() ? "" : ", ") << pending_faults_[next].describe();
+                any = true;
+            }
+        }
+        if (any) {
+            record_fault_phase(cycle);
+        }
+        return any;
+    }
+    
+    // Suspender a injeção dos nós e descartar nos routers os pacotes cuja
+    // rota usa um enlace rompido, enquanto a rede esvazia
+    void set_draining(bool draining) {
+        draining_ = draining;
+        for (auto& node : nodes_) {
+            node->setPaused(draining);
+        }
+        for (auto& router : routers_) {
+            router->setDraining(draining);
+        }
+    }
+    
+    // Nenhum pacote nos routers, canais e FIFOs entre domínios
+    bool network_empty() const {
+        std::vector<long long> ids;
+        for (const auto& router : routers_) {
+            router->collectInFlightIds(ids);
+        }
+        for (const auto& channel : channels_) {
+            channel->collectInFlightIds(ids);
+        }
+        for (const auto& crossing : crossings_) {
+            crossing->collectInFlightIds(ids);
+        }
+        return ids.empty();
+    }
+    
+    // Aplicar uma falha aos routers e nós; retorna false se a falha já
+    // estava aplicada. O roteamento é atualizado depois, em update_routing()
+    bool apply_fault(const FaultEvent& event) {
+        if (!faults_.apply(event)) {
+            return false;
+        }
+        
+        if (event.kind == FaultEvent::LINK) {
+            int port = FaultSchedule::linkPort(event.a, event.b, mesh_size_x_, mesh_size_y_);
+            routers_[event.a]->setPortFailed(port);
+            routers_[event.b]->setPortFailed(oppositeDirection(port));
+        } else {
+            routers_[event.a]->setFailed();
+            nodes_[event.a]->disable();
+            for (int port = 0; port < 4; port++) {
+                int neighbor = neighborRouter(event.a, port, mesh_size_x_, mesh_size_y_);
+                if (neighbor >= 0) {
+                    routers_[neighbor]->setPortFailed(oppositeDirection(port));
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Recalcular as tabelas up*/down* para as falhas aplicadas e os nós que
+    // continuam injetando e sendo destino
+    void update_routing() {
+        if (up_down_table_) {
+            up_down_table_->rebuild(faults_);
+        }
+        
+        // Nós vivos e alcançáveis continuam como destinos; os isolados por uma
+        // partição também deixam de injetar, pois nenhum destino lhes é alcançável
+        live_nodes_.clear();
+        live_routers_.assign(nodes_.size(), false);
+        for (int id = 0; id < static_cast<int>(nodes_.size()); id++) {
+            bool reachable = faults_.isRouterAlive(id) && (!up_down_table_ || up_down_table_->isReachable(id));
+            if (reachable) {
+                live_nodes_.push_back(id);
+                live_routers_[id] = true;
+            } else {
+                nodes_[id]->disable();
+            }
+        }
+        for (auto& node : nodes_) {
+            node->setDestinations(&live_nodes_);
+        }
+    }
+    
+    // IDs de todos os pacotes ainda presentes em nós, routers e enlaces
+    std::vector<long long> collect_in_flight_ids() const {
+        std::vector<long long> ids;
+        for (const auto& node : nodes_) {
+            node->collectInFlightIds(ids);
+        }
+        for (const auto& router : routers_) {
+            router->collectInFlightIds(ids);
+        }
+        for (const auto& channel : channels_) {
+            channel->collectInFlightIds(ids);
+        }
+        for (const auto& crossing : crossings_) {
+            crossing->collectInFlightIds(ids);
+        }
+        return ids;
+    }
+    
+    // Pacote na cabeça de uma fila acompanhado pelo watchdog: ID (-1 = fila
+    // vazia) e ciclo da verificação em que ele foi visto lá pela primeira vez
+    struct HeadWait {
+        long long packet_id;
+        int since;
+    };
+    
+    // Registrar o pacote visto agora na cabeça da fila; indica se ele mudou
+    static bool track_head(HeadWait& head_wait, const Packet* head, int cycle) {
+        long long packet_id = head ? head->getId() : -1;
+        if (packet_id == head_wait.packet_id) {
+            return false;
+        }
+        head_wait.packet_id = packet_id;
+        head_wait.since = cycle;
+        return true;
+    }
+    
+    // Nome da fila de índice index nas esperas do watchdog: buffers dos
+    // routers, depois saídas dos canais, depois FIFOs entre domínios
+    std::string head_wait_name(int index) const {
+        int c = index % Packet::NUM_MESSAGE_CLASSES;
+        int queue = index / Packet::NUM_MESSAGE_CLASSES;
+        int router_queues = static_cast<int>(routers_.size()) * 5;
+        if (queue < router_queues) {
+            return PortGraph::name(PortId{queue / 5, queue % 5, c});
+        }
+        
+        std::ostringstream name;
+        queue -= router_queues;
+        if (queue < static_cast<int>(channels_.size())) {
+            name << "channel " << channels_[queue]->name();
+        } else {
+            name << "clock crossing " << crossings_[queue - channels_.size()]->name();
+        }
+        name << " class " << c;
+        return name.str();
+    }
+    
+    // Indica se a fila do canal ou da FIFO entre domínios do enlace (router,
+    // porta de saída) está parada: nada atravessando e a cabeça da classe, se
+    // houver, sem se mover desde a verificação anterior do watchdog
+    bool link_queue_stuck(const std::vector<HeadWait>& head_waits, int now, int router, int port, int c) const {
+        int queue = static_cast<int>(routers_.size()) * 5;
+        int channel = link_channels_[router * 5 + port];
+        int crossing = link_crossings_[router * 5 + port];
+        if (channel >= 0) {
+            if (channels_[channel]->hasPacketInTransit()) {
+                return false;
+            }
+            queue += channel;
+        } else if (crossing >= 0) {
+            if (crossings_[crossing]->hasPacketInTransit()) {
+                return false;
+            }
+            queue += static_cast<int>(channels_.size()) + crossing;
+        } else {
+            return true;
+        }
+        const HeadWait& head_wait = head_waits[queue * Packet::NUM_MESSAGE_CLASSES + c];
+        return head_wait.packet_id < 0 || head_wait.since < now;
+    }
+    
+    // Montar o grafo de espera: um buffer de entrada espera pelo buffer da mesma
+    // classe no vizinho para onde seu pacote de cabeça vai, quando esse buffer está
+    // cheio; só entram cabeças (e canais ou FIFOs no caminho) paradas desde a
+    // verificação anterior do watchdog
+    bool find_wait_for_cycle(const std::vector<HeadWait>& head_waits, int now, std::vector<PortId>& cycle) const {
+        PortGraph wait_for(static_cast<int>(routers_.size()), Router::NUM_CLASSES);
+        for (size_t r = 0; r < routers_.size(); r++) {
+            for (int port = 0; port < 5; port++) {
+                for (int c = 0; c < Router::NUM_CLASSES; c++) {
+                    const HeadWait& head_wait = head_waits[(r * 5 + port) * Router::NUM_CLASSES + c];
+                    if (head_wait.packet_id < 0 || head_wait.since >= now) {
+                        continue;
+                    }
+                    
+                    int output_port = routers_[r]->getHeadOutputPort(port, c);
+                    int neighbor = neighborRouter(static_cast<int>(r), output_port, mesh_size_x_, mesh_size_y_);
+                    if (neighbor < 0) {
+                        continue;
+                    }
+                    
+                    int neighbor_port = oppositeDirection(output_port);
+                    if (routers_[neighbor]->getBufferOccupancy(neighbor_port, c) >= Router::BUFFER_SIZE &&
+                        link_queue_stuck(head_waits, now, static_cast<int>(r), output_port, c)) {
+                        wait_for.addEdge(PortId{static_cast<int>(r), port, c}, PortId{neighbor, neighbor_port, c});
+                    }
+                }
+            }
+        }
+        return wait_for.findCycle(cycle);
+    }
+    
+#ifdef NOC_ROUTER_STATS
+    RouterStatsSeries stats_series_;          // Série temporal dos contadores por época
+    
+    std::vector<RouterCounters> collect_router_counters() const {
+        std::vector<RouterCounters> counters;
+        counters.reserve(routers_.size());
+        for (const auto& router : routers_) {
+            counters.push_back(router->getCounters());
+        }
+        return counters;
+    }
+    
+    void write_router_stats_series() {
+        if (stats_epoch_ <= 0 || stats_output_prefix_.empty()) {
+            return;
+        }
+        
+        if (stats_series_.writeCsv(stats_output_prefix_ + ".csv") &&
+            stats_series_.writeHeatmapJson(stats_output_prefix_ + ".json")) {
+            std::cout << "Router stats time series written to " << stats_output_prefix_
+                      << ".csv/.json" << std::endl;
+        } else {
+            std::cout << "Error: could not write router stats to " << stats_output_prefix_ << std::endl;
+        }
+    }
+#endif
     
     sc_clock* clk;                            // Clock do sistema
     
     std::vector<std::unique_ptr<Node>> nodes_;               // Nós da rede
-    std::vector<std::unique_ptr<Router>> routers_;           // Routers da rede
+    std::vector<std::unique_ptr<BaseRouter>> routers_;       // Routers da rede
     std::vector<std::unique_ptr<Channel>> channels_;         // Canais da rede
-    std::vector<std::unique_ptr<RoutingAlgorithm>> routing_algorithms_;  // Algoritmos de roteamento
+    
+    ClockDomainConfig clock_domains_;                                 // Domínios de clock e DVFS
+    std::vector<std::unique_ptr<ClockGenerator>> domain_clocks_;      // Clock de cada domínio (vazio = só clk)
+    std::vector<std::unique_ptr<ClockCrossing>> crossings_;           // FIFOs entre domínios
+    std::vector<int> link_channels_;          // Canal de cada (router * 5 + porta de saída), -1 = nenhum
+    std::vector<int> link_crossings_;         // FIFO entre domínios de cada (router * 5 + porta de saída), -1 = nenhuma
     
     // Sinais para conectar componentes
     std::vector<std::unique_ptr<sc_signal<Packet>>> packet_signals_;
     std::vector<std::unique_ptr<sc_signal<bool>>> valid_signals_;
-    std::vector<std::unique_ptr<sc_signal<bool>>> ready_signals_;
+    std::vector<std::unique_ptr<sc_signal<int>>> ready_signals_;   // Máscaras de pronto e créditos por classe
+    
+    // Criar um gerador de clock por domínio, com as mudanças DVFS agendadas
+    void create_clock_domains() {
+        for (int d = 0; d < clock_domains_.getNumDomains(); d++) {
+            ClockGenerator* domain_clock = new ClockGenerator(("clock_domain_" + std::to_string(d)).c_str(), d,
+                                                              sc_time(clock_domains_.periods_ns[d], SC_NS));
+            domain_clocks_.push_back(std::unique_ptr<ClockGenerator>(domain_clock));
+        }
+        for (const auto& event : clock_domains_.dvfs_events) {
+            domain_clocks_[event.domain]->scheduleChange(sc_time(event.time_ns, SC_NS), sc_time(event.period_ns, SC_NS));
+        }
+    }
+    
+    // Clock que move os componentes de um domínio
+    sc_signal_in_if<bool>& domain_clock(int domain) {
+        if (domain_clocks_.empty()) {
+            return *clk;
+        }
+        return domain_clocks_[domain]->clk;
+    }
+    
+    // Ligar os sinais de um remetente às portas de entrada de um destino; se
+    // estiverem em domínios de clock diferentes, o enlace passa por uma FIFO de
+    // sincronização, que serializa os pacotes em width bytes por ciclo (0 = inteiro)
+    void bind_receiver(sc_signal<Packet>& packet, sc_signal<bool>& valid, sc_signal<int>& ready,
+                       sc_in<Packet>& in_packet, sc_in<bool>& in_valid, sc_out<int>& in_ready,
+                       int from_domain, int to_domain, const std::string& base, int width = 0) {
+        if (from_domain == to_domain) {
+            in_packet.bind(packet);
+            in_valid.bind(valid);
+            in_ready.bind(ready);
+            return;
+        }
+        
+        // Sinais do lado do destino
+        auto sync_packet = std::make_unique<sc_signal<Packet>>((base + "_sync_packet").c_str());
+        auto sync_valid = std::make_unique<sc_signal<bool>>((base + "_sync_valid").c_str());
+        auto sync_ready = std::make_unique<sc_signal<int>>((base + "_sync_ready").c_str());
+        
+        ClockCrossing* crossing = new ClockCrossing(("crossing_" + base).c_str(),
+                                                    clock_domains_.sync_stages, clock_domains_.fifo_depth, width);
+        crossing->clk_in(domain_clock(from_domain));
+        crossing->clk_out(domain_clock(to_domain));
+        crossing->in_packet.bind(packet);
+        crossing->in_valid.bind(valid);
+        crossing->in_ready.bind(ready);
+        crossing->out_packet.bind(*sync_packet);
+        crossing->out_valid.bind(*sync_valid);
+        crossing->out_ready.bind(*sync_ready);
+        
+        in_packet.bind(*sync_packet);
+        in_valid.bind(*sync_valid);
+        in_ready.bind(*sync_ready);
+        
+        crossings_.push_back(std::unique_ptr<ClockCrossing>(crossing));
+        packet_signals_.push_back(std::move(sync_packet));
+        valid_signals_.push_back(std::move(sync_valid));
+        ready_signals_.push_back(std::move(sync_ready));
+    }
+    
+    // Criar o algoritmo de roteamento de um router; UP_DOWN consulta as
+    // tabelas compartilhadas, recalculadas a cada falha
+    RoutingAlgorithm* create_routing_algorithm() {
+        if (routing_algorithm_name_ == "UP_DOWN") {
+            if (!up_down_table_) {
+                up_down_table_ = std::make_shared<UpDownRoutingTable>();
+                up_down_table_->rebuild(faults_);
+            }
+            return new UpDownRoutingAlgorithm(up_down_table_, mesh_size_x_);
+        }
+        return createRoutingAlgorithm(routing_algorithm_name_);
+    }
     
     // Criar a topologia da rede
     void create_network() {
+        link_channels_.assign(mesh_size_x_ * mesh_size_y_ * 5, -1);
+        link_crossings_.assign(mesh_size_x_ * mesh_size_y_ * 5, -1);
+        
         // Criar nós e routers
         for (int y = 0; y < mesh_size_y_; y++) {
             for (int x = 0; x < mesh_size_x_; x++) {
                 int node_id = y * mesh_size_x_ + x;
                 
-                // Criar algoritmo de roteamento para este router
-                RoutingAlgorithm* routing_algorithm = createRoutingAlgorithm(routing_algorithm_name_);
-                routing_algorithms_.push_back(std::unique_ptr<RoutingAlgorithm>(routing_algorithm));
+                // Criar algoritmo de roteamento para este router (o router assume a posse)
+                RoutingAlgorithm* routing_algorithm = create_routing_algorithm();
                 
                 // Criar router
                 std::string router_name = "router_" + std::to_string(node_id);
-                Router* router = new Router(router_name.c_str(), x, y, mesh_size_x_, mesh_size_y_, routing_algorithm);
-                router->clk(*clk);
-                routers_.push_back(std::unique_ptr<Router>(router));
+                BaseRouter* router;
+                if (router_type_ == "bufferless") {
+                    router = new DeflectionRouter(router_name.c_str(), x, y, mesh_size_x_, mesh_size_y_, routing_algorithm);
+                } else {
+                    router = new Router(router_name.c_str(), x, y, mesh_size_x_, mesh_size_y_, routing_algorithm);
+                }
+                router->clk(domain_clock(clock_domains_.routerDomain(node_id)));
+                router->setScoreboard(&scoreboard_);
+                routers_.push_back(std::unique_ptr<BaseRouter>(router));
                 
                 // Criar nó
                 std::string node_name = "node_" + std::to_string(node_id);
                 Node* node = new Node(node_name.c_str(), node_id, mesh_size_x_ * mesh_size_y_, 
                                      packet_injection_rate_, simulation_time_);
-                node->clk(*clk);
+                node->clk(domain_clock(clock_domains_.nodeDomain(node_id)));
+                node->setScoreboard(&scoreboard_);
+                if (!domain_clocks_.empty()) {
+                    node->setReferencePeriod(clk->period());
+                }
                 nodes_.push_back(std::unique_ptr<Node>(node));
             }
         }
@@ -150,18 +1641,18 @@ private:
         for (int y = 0; y < mesh_size_y_; y++) {
             for (int x = 0; x < mesh_size_x_; x++) {
                 int node_id = y * mesh_size_x_ + x;
-                Router* router = routers_[node_id].get();
+                BaseRouter* router = routers_[node_id].get();
                 Node* node = nodes_[node_id].get();
                 
                 // Conectar nó à porta local do router usando sinais
                 // Criar sinais para comunicação nó-router
                 auto node_to_router_packet = std::make_unique<sc_signal<Packet>>(("sig_node_to_router_packet_" + std::to_string(node_id)).c_str());
                 auto node_to_router_valid = std::make_unique<sc_signal<bool>>(("sig_node_to_router_valid_" + std::to_string(node_id)).c_str());
-                auto node_to_router_ready = std::make_unique<sc_signal<bool>>(("sig_node_to_router_ready_" + std::to_string(node_id)).c_str());
+                auto node_to_router_ready = std::make_unique<sc_signal<int>>(("sig_node_to_router_ready_" + std::to_string(node_id)).c_str());
                 
                 auto router_to_node_packet = std::make_unique<sc_signal<Packet>>(("sig_router_to_node_packet_" + std::to_string(node_id)).c_str());
                 auto router_to_node_valid = std::make_unique<sc_signal<bool>>(("sig_router_to_node_valid_" + std::to_string(node_id)).c_str());
-                auto router_to_node_ready = std::make_unique<sc_signal<bool>>(("sig_router_to_node_ready_" + std::to_string(node_id)).c_str());
+                auto router_to_node_ready = std::make_unique<sc_signal<int>>(("sig_router_to_node_ready_" + std::to_string(node_id)).c_str());
                 
                 // Conectar saídas do nó aos sinais
                 node->out_packet.bind(*node_to_router_packet);
@@ -169,9 +1660,11 @@ private:
                 node->out_ready.bind(*node_to_router_ready);
                 
                 // Conectar entradas LOCAL do router aos sinais
-                router->in_packets[LOCAL].bind(*node_to_router_packet);
-                router->in_valids[LOCAL].bind(*node_to_router_valid);
-                router->in_readys[LOCAL].bind(*node_to_router_ready);
+                int node_domain = clock_domains_.nodeDomain(node_id);
+                int router_domain = clock_domains_.routerDomain(node_id);
+                bind_receiver(*node_to_router_packet, *node_to_router_valid, *node_to_router_ready,
+                              router->in_packets[LOCAL], router->in_valids[LOCAL], router->in_readys[LOCAL],
+                              node_domain, router_domain, "node_to_router_" + std::to_string(node_id));
                 
                 // Conectar saídas LOCAL do router aos sinais
                 router->out_packets[LOCAL].bind(*router_to_node_packet);
@@ -179,9 +1672,9 @@ private:
                 router->out_readys[LOCAL].bind(*router_to_node_ready);
                 
                 // Conectar entradas do nó aos sinais
-                node->in_packet.bind(*router_to_node_packet);
-                node->in_valid.bind(*router_to_node_valid);
-                node->in_ready.bind(*router_to_node_ready);
+                bind_receiver(*router_to_node_packet, *router_to_node_valid, *router_to_node_ready,
+                              node->in_packet, node->in_valid, node->in_ready,
+                              router_domain, node_domain, "router_to_node_" + std::to_string(node_id));
                 
                 // Armazenar sinais
                 packet_signals_.push_back(std::move(node_to_router_packet));
@@ -203,103 +1696,106 @@ private:
     // Conectar um router aos seus vizinhos
     void connect_routers(int x, int y) {
         int router_id = y * mesh_size_x_ + x;
-        Router* router = routers_[router_id].get();
         
-        // Conectar ao vizinho NORTE
+        // Conectar ao vizinho NORTE (saída NORTE do router -> entrada SUL do vizinho e vice-versa)
         if (y > 0) {
             int north_id = (y - 1) * mesh_size_x_ + x;
-            Router* north_router = routers_[north_id].get();
-            
-            // Criar sinais para comunicação router-para-norte
-            auto router_to_north_packet = std::make_unique<sc_signal<Packet>>(("sig_r" + std::to_string(router_id) + "_to_n" + std::to_string(north_id) + "_packet").c_str());
-            auto router_to_north_valid = std::make_unique<sc_signal<bool>>(("sig_r" + std::to_string(router_id) + "_to_n" + std::to_string(north_id) + "_valid").c_str());
-            auto router_to_north_ready = std::make_unique<sc_signal<bool>>(("sig_r" + std::to_string(router_id) + "_to_n" + std::to_string(north_id) + "_ready").c_str());
-            
-            auto north_to_router_packet = std::make_unique<sc_signal<Packet>>(("sig_n" + std::to_string(north_id) + "_to_r" + std::to_string(router_id) + "_packet").c_str());
-            auto north_to_router_valid = std::make_unique<sc_signal<bool>>(("sig_n" + std::to_string(north_id) + "_to_r" + std::to_string(router_id) + "_valid").c_str());
-            auto north_to_router_ready = std::make_unique<sc_signal<bool>>(("sig_n" + std::to_string(north_id) + "_to_r" + std::to_string(router_id) + "_ready").c_str());
-            
-            // Conectar saídas NORTE do router às entradas SUL do router norte
-            router->out_packets[NORTH].bind(*router_to_north_packet);
-            router->out_valids[NORTH].bind(*router_to_north_valid);
-            router->out_readys[NORTH].bind(*router_to_north_ready);
-            
-            north_router->in_packets[SOUTH].bind(*router_to_north_packet);
-            north_router->in_valids[SOUTH].bind(*router_to_north_valid);
-            north_router->in_readys[SOUTH].bind(*router_to_north_ready);
-            
-            // Conectar saídas SUL do router norte às entradas NORTE do router
-            north_router->out_packets[SOUTH].bind(*north_to_router_packet);
-            north_router->out_valids[SOUTH].bind(*north_to_router_valid);
-            north_router->out_readys[SOUTH].bind(*north_to_router_ready);
-            
-            router->in_packets[NORTH].bind(*north_to_router_packet);
-            router->in_valids[NORTH].bind(*north_to_router_valid);
-            router->in_readys[NORTH].bind(*north_to_router_ready);
-            
-            // Armazenar sinais
-            packet_signals_.push_back(std::move(router_to_north_packet));
-            valid_signals_.push_back(std::move(router_to_north_valid));
-            ready_signals_.push_back(std::move(router_to_north_ready));
-            packet_signals_.push_back(std::move(north_to_router_packet));
-            valid_signals_.push_back(std::move(north_to_router_valid));
-            ready_signals_.push_back(std::move(north_to_router_ready));
+            connect_link(router_id, NORTH, north_id, SOUTH,
+                         "sig_r" + std::to_string(router_id) + "_to_n" + std::to_string(north_id));
+            connect_link(north_id, SOUTH, router_id, NORTH,
+                         "sig_n" + std::to_string(north_id) + "_to_r" + std::to_string(router_id));
         }
         
-        // Conectar ao vizinho LESTE
+        // Conectar ao vizinho LESTE (saída LESTE do router -> entrada OESTE do vizinho e vice-versa)
         if (x < mesh_size_x_ - 1) {
             int east_id = y * mesh_size_x_ + (x + 1);
-            Router* east_router = routers_[east_id].get();
-            
-            // Criar sinais para comunicação router-para-leste
-            auto router_to_east_packet = std::make_unique<sc_signal<Packet>>(("sig_r" + std::to_string(router_id) + "_to_e" + std::to_string(east_id) + "_packet").c_str());
-            auto router_to_east_valid = std::make_unique<sc_signal<bool>>(("sig_r" + std::to_string(router_id) + "_to_e" + std::to_string(east_id) + "_valid").c_str());
-            auto router_to_east_ready = std::make_unique<sc_signal<bool>>(("sig_r" + std::to_string(router_id) + "_to_e" + std::to_string(east_id) + "_ready").c_str());
-            
-            auto east_to_router_packet = std::make_unique<sc_signal<Packet>>(("sig_e" + std::to_string(east_id) + "_to_r" + std::to_string(router_id) + "_packet").c_str());
-            auto east_to_router_valid = std::make_unique<sc_signal<bool>>(("sig_e" + std::to_string(east_id) + "_to_r" + std::to_string(router_id) + "_valid").c_str());
-            auto east_to_router_ready = std::make_unique<sc_signal<bool>>(("sig_e" + std::to_string(east_id) + "_to_r" + std::to_string(router_id) + "_ready").c_str());
-            
-            // Conectar saídas LESTE do router às entradas OESTE do router leste
-            router->out_packets[EAST].bind(*router_to_east_packet);
-            router->out_valids[EAST].bind(*router_to_east_valid);
-            router->out_readys[EAST].bind(*router_to_east_ready);
-            
-            east_router->in_packets[WEST].bind(*router_to_east_packet);
-            east_router->in_valids[WEST].bind(*router_to_east_valid);
-            east_router->in_readys[WEST].bind(*router_to_east_ready);
+            connect_link(router_id, EAST, east_id, WEST,
+                         "sig_r" + std::to_string(router_id) + "_to_e" + std::to_string(east_id));
+            connect_link(east_id, WEST, router_id, EAST,
+                         "sig_e" + std::to_string(east_id) + "_to_r" + std::to_string(router_id));
+        }
+    }
+    
+    // Conectar a saída from_port do router from_id à entrada to_port do router to_id.
+    // Enlaces de 1 ciclo usam sinais diretos; os demais passam por um Channel em pipeline.
+    // Entre domínios de clock diferentes, a FIFO de sincronização substitui o
+    // enlace, com a mesma largura (a latência do enlace não é somada).
+    void connect_link(int from_id, Direction from_port, int to_id, Direction to_port,
+                      const std::string& base) {
+        BaseRouter* from = routers_[from_id].get();
+        BaseRouter* to = routers_[to_id].get();
+        LinkConfig config = link_table_.get(from_id, to_id);
+        
+        // Sinais do lado do remetente
+        auto packet = std::make_unique<sc_signal<Packet>>((base + "_packet").c_str());
+        auto valid = std::make_unique<sc_signal<bool>>((base + "_valid").c_str());
+        auto ready = std::make_unique<sc_signal<int>>((base + "_ready").c_str());
+        
+        from->out_packets[from_port].bind(*packet);
+        from->out_valids[from_port].bind(*valid);
+        from->out_readys[from_port].bind(*ready);
+        
+        int from_domain = clock_domains_.routerDomain(from_id);
+        int to_domain = clock_domains_.routerDomain(to_id);
+        if (config.isDirect(max_packet_bytes_) || from_domain != to_domain) {
+            bind_receiver(*packet, *valid, *ready,
+                          to->in_packets[to_port], to->in_valids[to_port], to->in_readys[to_port],
+                          from_domain, to_domain, base, config.width);
+            if (from_domain != to_domain) {
+                link_crossings_[from_id * 5 + from_port] = static_cast<int>(crossings_.size()) - 1;
+                from->setLinkWidth(from_port, config.width);
+            }
+        } else {
+            // Sinais do lado do destino
+            auto link_packet = std::make_unique<sc_signal<Packet>>((base + "_link_packet").c_str());
+            auto link_valid = std::make_unique<sc_signal<bool>>((base + "_link_valid").c_str());
+            auto link_ready = std::make_unique<sc_signal<int>>((base + "_link_ready").c_str());
+            auto link_credit = std::make_unique<sc_signal<int>>((base + "_link_credit").c_str());
             
-            // Conectar saídas OESTE do router leste às entradas LESTE do router
-            east_router->out_packets[WEST].bind(*east_to_router_packet);
-            east_router->out_valids[WEST].bind(*east_to_router_valid);
-            east_router->out_readys[WEST].bind(*east_to_router_ready);
+            // Os créditos do enlace cobrem o buffer de entrada do destino
+            Channel* channel = new Channel(("channel_" + std::to_string(from_id) + "_to_" + std::to_string(to_id)).c_str(),
+                                           config.latency, config.credit_delay, config.width, Router::BUFFER_SIZE);
+            channel->clk(domain_clock(from_domain));
+            from->setLinkWidth(from_port, config.width);
+            channel->in_packet.bind(*packet);
+            channel->in_valid.bind(*valid);
+            channel->in_ready.bind(*ready);
+            channel->out_packet.bind(*link_packet);
+            channel->out_valid.bind(*link_valid);
+            channel->out_ready.bind(*link_ready);
+            channel->credit_in.bind(*link_credit);
             
-            router->in_packets[EAST].bind(*east_to_router_packet);
-            router->in_valids[EAST].bind(*east_to_router_valid);
-            router->in_readys[EAST].bind(*east_to_router_ready);
+            to->in_packets[to_port].bind(*link_packet);
+            to->in_valids[to_port].bind(*link_valid);
+            to->in_readys[to_port].bind(*link_ready);
+            to->setCreditSignal(to_port, link_credit.get());
             
-            // Armazenar sinais
-            packet_signals_.push_back(std::move(router_to_east_packet));
-            valid_signals_.push_back(std::move(router_to_east_valid));
-            ready_signals_.push_back(std::move(router_to_east_ready));
-            packet_signals_.push_back(std::move(east_to_router_packet));
-            valid_signals_.push_back(std::move(east_to_router_valid));
-            ready_signals_.push_back(std::move(east_to_router_ready));
+            link_channels_[from_id * 5 + from_port] = static_cast<int>(channels_.size());
+            channels_.push_back(std::unique_ptr<Channel>(channel));
+            packet_signals_.push_back(std::move(link_packet));
+            valid_signals_.push_back(std::move(link_valid));
+            ready_signals_.push_back(std::move(link_ready));
+            ready_signals_.push_back(std::move(link_credit));
         }
+        
+        // Armazenar sinais
+        packet_signals_.push_back(std::move(packet));
+        valid_signals_.push_back(std::move(valid));
+        ready_signals_.push_back(std::move(ready));
     }
     
     // Conectar portas não utilizadas a sinais dummy
-    void connect_unused_ports(Router* router, int x, int y) {
+    void connect_unused_ports(BaseRouter* router, int x, int y) {
         int router_id = y * mesh_size_x_ + x;
         
         // Conectar portas NORTE não utilizadas
         if (y == 0) {
             auto dummy_north_in_packet = std::make_unique<sc_signal<Packet>>(("dummy_north_in_packet_" + std::to_string(router_id)).c_str());
             auto dummy_north_in_valid = std::make_unique<sc_signal<bool>>(("dummy_north_in_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_north_in_ready = std::make_unique<sc_signal<bool>>(("dummy_north_in_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_north_in_ready = std::make_unique<sc_signal<int>>(("dummy_north_in_ready_" + std::to_string(router_id)).c_str());
             auto dummy_north_out_packet = std::make_unique<sc_signal<Packet>>(("dummy_north_out_packet_" + std::to_string(router_id)).c_str());
             auto dummy_north_out_valid = std::make_unique<sc_signal<bool>>(("dummy_north_out_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_north_out_ready = std::make_unique<sc_signal<bool>>(("dummy_north_out_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_north_out_ready = std::make_unique<sc_signal<int>>(("dummy_north_out_ready_" + std::to_string(router_id)).c_str());
             
             router->in_packets[NORTH].bind(*dummy_north_in_packet);
             router->in_valids[NORTH].bind(*dummy_north_in_valid);
@@ -320,10 +1816,10 @@ private:
         if (y == mesh_size_y_ - 1) {
             auto dummy_south_in_packet = std::make_unique<sc_signal<Packet>>(("dummy_south_in_packet_" + std::to_string(router_id)).c_str());
             auto dummy_south_in_valid = std::make_unique<sc_signal<bool>>(("dummy_south_in_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_south_in_ready = std::make_unique<sc_signal<bool>>(("dummy_south_in_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_south_in_ready = std::make_unique<sc_signal<int>>(("dummy_south_in_ready_" + std::to_string(router_id)).c_str());
             auto dummy_south_out_packet = std::make_unique<sc_signal<Packet>>(("dummy_south_out_packet_" + std::to_string(router_id)).c_str());
             auto dummy_south_out_valid = std::make_unique<sc_signal<bool>>(("dummy_south_out_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_south_out_ready = std::make_unique<sc_signal<bool>>(("dummy_south_out_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_south_out_ready = std::make_unique<sc_signal<int>>(("dummy_south_out_ready_" + std::to_string(router_id)).c_str());
             
             router->in_packets[SOUTH].bind(*dummy_south_in_packet);
             router->in_valids[SOUTH].bind(*dummy_south_in_valid);
@@ -344,10 +1840,10 @@ private:
         if (x == 0) {
             auto dummy_west_in_packet = std::make_unique<sc_signal<Packet>>(("dummy_west_in_packet_" + std::to_string(router_id)).c_str());
             auto dummy_west_in_valid = std::make_unique<sc_signal<bool>>(("dummy_west_in_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_west_in_ready = std::make_unique<sc_signal<bool>>(("dummy_west_in_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_west_in_ready = std::make_unique<sc_signal<int>>(("dummy_west_in_ready_" + std::to_string(router_id)).c_str());
             auto dummy_west_out_packet = std::make_unique<sc_signal<Packet>>(("dummy_west_out_packet_" + std::to_string(router_id)).c_str());
             auto dummy_west_out_valid = std::make_unique<sc_signal<bool>>(("dummy_west_out_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_west_out_ready = std::make_unique<sc_signal<bool>>(("dummy_west_out_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_west_out_ready = std::make_unique<sc_signal<int>>(("dummy_west_out_ready_" + std::to_string(router_id)).c_str());
             
             router->in_packets[WEST].bind(*dummy_west_in_packet);
             router->in_valids[WEST].bind(*dummy_west_in_valid);
@@ -368,10 +1864,10 @@ private:
         if (x == mesh_size_x_ - 1) {
             auto dummy_east_in_packet = std::make_unique<sc_signal<Packet>>(("dummy_east_in_packet_" + std::to_string(router_id)).c_str());
             auto dummy_east_in_valid = std::make_unique<sc_signal<bool>>(("dummy_east_in_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_east_in_ready = std::make_unique<sc_signal<bool>>(("dummy_east_in_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_east_in_ready = std::make_unique<sc_signal<int>>(("dummy_east_in_ready_" + std::to_string(router_id)).c_str());
             auto dummy_east_out_packet = std::make_unique<sc_signal<Packet>>(("dummy_east_out_packet_" + std::to_string(router_id)).c_str());
             auto dummy_east_out_valid = std::make_unique<sc_signal<bool>>(("dummy_east_out_valid_" + std::to_string(router_id)).c_str());
-            auto dummy_east_out_ready = std::make_unique<sc_signal<bool>>(("dummy_east_out_ready_" + std::to_string(router_id)).c_str());
+            auto dummy_east_out_ready = std::make_unique<sc_signal<int>>(("dummy_east_out_ready_" + std::to_string(router_id)).c_str());
             
             router->in_packets[EAST].bind(*dummy_east_in_packet);
             router->in_valids[EAST].bind(*dummy_east_in_valid);
@@ -2,10 +2,18 @@
 #define NODE_H
 
 #include <systemc.h>
+#include <algorithm>
+#include <deque>
 #include <queue>
+#include <unordered_map>
 #include <vector>
 #include <random>
 #include "packet.h"
+#include "scoreboard.h"
+#include "traffic.h"
+#include "latency_histogram.h"
+#include "checkpoint.h"
+#include "event_trace.h"
 
 // Nó para Network-on-Chip
 class Node : public sc_module {
@@ -16,11 +24,11 @@ public:
     // Conexão da porta local para o roteador
     sc_out<Packet> out_packet;  // Saída para o roteador
     sc_out<bool> out_valid;     // Sinal de validade da saída
-    sc_in<bool> out_ready;      // Sinal de pronto do roteador
+    sc_in<int> out_ready;       // Máscara de classes aceitas pelo roteador
     
     sc_in<Packet> in_packet;    // Entrada do roteador
     sc_in<bool> in_valid;       // Sinal de validade do roteador
-    sc_out<bool> in_ready;      // Sinal de pronto da entrada
+    sc_out<int> in_ready;       // Máscara de classes aceitas pela entrada
 
     // Construtor
     Node(sc_module_name name, int id, int total_nodes, int packet_injection_rate = 10,
@@ -33,37 +41,71 @@ public:
         packets_sent_(0),
         packets_received_(0),
         current_time_(0),
+        reference_period_(SC_ZERO_TIME),
+        time_origin_(SC_ZERO_TIME),
+        next_local_id_(0),
+        scoreboard_(nullptr),
+        trace_(nullptr),
+        enabled_(true),
+        paused_(false),
+        destinations_(nullptr),
+        memory_controller_(false),
+        requests_sent_(0),
+        replies_received_(0),
+        requests_served_(0),
+        total_round_trip_(0),
+        max_round_trip_(0),
+        multicasts_sent_(0),
+        multicast_destinations_(0),
+        multicast_injections_(0),
         rng_(std::random_device()()) {
         
         // Registrar processos
         SC_METHOD(process_send);
         sensitive << clk.pos();
+        dont_initialize();
         
         SC_METHOD(process_receive);
         sensitive << clk.pos();
+        dont_initialize();
     }
 
     // Processo para enviar pacotes
     void process_send() {
-        // Atualizar tempo
-        current_time_++;
+        // Atualizar tempo: ciclos do próprio clock ou, com vários domínios de
+        // clock, ciclos do clock de referência, comparáveis entre nós
+        if (reference_period_ == SC_ZERO_TIME) {
+            current_time_++;
+        } else {
+            current_time_ = static_cast<int>((sc_time_stamp() - time_origin_) / reference_period_) + 1;
+        }
         
-        // Verificar se estamos prontos para enviar e o roteador pode receber
-        if (out_ready.read()) {
-            // Tentar enviar um novo pacote baseado na taxa de injeção
-            if (generate_packet()) {
-                // Criar um novo pacote
-                int dest_id = generate_destination();
-                int payload = rand() % 1000;
-                Packet packet(id_, dest_id, Packet::DATA, payload, current_time_);
-                
+        // Controladores de memória só enviam respostas; os demais nós, pedidos
+        // ou dados, sempre na classe de pedidos
+        int send_class = memory_controller_ ? Packet::REPLY_CLASS : Packet::REQUEST_CLASS;
+        
+        // Verificar se estamos prontos para enviar e o roteador pode receber a classe
+        if (out_ready.read() & Packet::classMask(send_class)) {
+            Packet packet;
+            if (enabled_ && !paused_ && next_packet(packet)) {
                 // Enviar pacote
                 out_packet.write(packet);
                 out_valid.write(true);
                 packets_sent_++;
+                bytes_sent_ += packet.getSizeBytes();
+                if (packet.isMulticast()) {
+                    multicast_injections_++;
+                }
+                if (trace_) {
+                    trace_->record(TraceEvent::INJECT, packet.getId(), id_, TraceEvent::LOCAL_PORT, id_, packet.getDstId(),
+                                   packet.isMulticast());
+                }
                 
-                std::cout << "Node " << id_ << " sending packet to " << dest_id 
-                          << " (payload: " << payload << ") at time " << current_time_ << std::endl;
+                std::cout << "Node " << id_ << " sending packet to " << packet.getDstId();
+                if (packet.isMulticast()) {
+                    std::cout << " (multicast, " << packet.getDestinations().count() << " destinations)";
+                }
+                std::cout << " (payload: " << packet.getPayload() << ") at time " << current_time_ << std::endl;
             } else {
                 // Nenhum pacote para enviar neste ciclo
                 out_valid.write(false);
@@ -73,14 +115,26 @@ public:
 
     // Processo para receber pacotes
     void process_receive() {
-        // Sempre pronto para receber
-        in_ready.write(true);
+        // Sempre pronto para receber, em todas as classes
+        in_ready.write(Packet::ALL_CLASSES_MASK);
         
         // Se há um pacote válido chegando, recebê-lo
         if (in_valid.read()) {
             // Ler pacote
             Packet packet = in_packet.read();
             packets_received_++;
+            bytes_received_ += packet.getSizeBytes();
+            if (trace_) {
+                trace_->record(TraceEvent::EJECT, packet.getId(), id_, TraceEvent::LOCAL_PORT, packet.getSrcId(), id_,
+                               packet.isMulticast());
+            }
+            
+            // Conferir entrega única e destino correto
+            bool complete = false;
+            if (scoreboard_ && !scoreboard_->recordDelivery(packet.getId(), id_, complete)) {
+                std::cout << "Node " << id_ << " scoreboard error: unexpected " << packet
+                          << " at time " << current_time_ << std::endl;
+            }
             
             // Calcular latência
             int latency = packet.getLatency(current_time_);
@@ -89,13 +143,195 @@ public:
             // Registrar estatísticas
             total_latency_ += latency;
             total_hops_ += hops;
+            total_deflections_ += packet.getDeflections();
+            class_latency_[packet.getTrafficClass()].add(latency);
+            
+            // Multicast: latência até cada destino e, na última entrega, até o último
+            if (packet.isMulticast()) {
+                multicast_latency_.add(latency);
+                if (complete) {
+                    multicast_completion_.add(latency);
+                }
+            }
             
             // Imprimir informações do pacote
             std::cout << "Node " << id_ << " received " << packet 
                       << " at time " << current_time_
                       << " (Latency: " << latency 
                       << ", Hops: " << hops << ")" << std::endl;
+            
+            if (traffic_.mode == TrafficConfig::REQUEST_REPLY) {
+                handle_protocol_packet(packet);
+            }
+        }
+    }
+
+    // Escolher o próximo pacote a injetar conforme o modo de tráfego
+    bool next_packet(Packet& packet) {
+        if (traffic_.mode == TrafficConfig::UNIFORM) {
+            // Cópias de um multicast emulado saem uma por ciclo, antes de novos pacotes
+            if (!unicast_copies_.empty()) {
+                packet = unicast_copies_.front();
+                unicast_copies_.pop_front();
+                return true;
+            }
+            
+            // Tentar enviar um novo pacote baseado na taxa de injeção
+            if (!generate_packet()) {
+                return false;
+            }
+            if (traffic_.multicast_rate > 0) {
+                std::uniform_int_distribution<> dist(1, 100);
+                if (dist(rng_) <= traffic_.multicast_rate) {
+                    return generate_multicast(packet);
+                }
+            }
+            int dest_id = generate_destination();
+            if (dest_id < 0) {
+                return false;
+            }
+            packet = Packet(id_, dest_id, Packet::DATA, payload_distribution_(rng_), current_time_);
+            packet.setTrafficClass(generate_traffic_class());
+            packet.setSizeBytes(generate_packet_size());
+            packet.setId(allocate_packet_id(dest_id));
+            return true;
+        }
+        
+        if (memory_controller_) {
+            // Responder ao pedido mais antigo cujo tempo de serviço terminou
+            if (pending_replies_.empty() || pending_replies_.front().ready_time > current_time_) {
+                return false;
+            }
+            const PendingReply& reply = pending_replies_.front();
+            packet = Packet(id_, reply.dst_id, Packet::DATA, reply.payload, current_time_);
+            packet.setMessageClass(Packet::REPLY_CLASS);
+            packet.setRequestId(reply.request_id);
+            packet.setTrafficClass(reply.traffic_class);
+            packet.setSizeBytes(generate_packet_size());
+            packet.setId(allocate_packet_id(reply.dst_id));
+            pending_replies_.pop_front();
+            return true;
+        }
+        
+        // Emitir um pedido se há espaço para mais pedidos pendentes (malha fechada)
+        if (traffic_.memory_controllers.empty() ||
+            static_cast<int>(outstanding_requests_.size()) >= traffic_.max_outstanding ||
+            !generate_packet()) {
+            return false;
+        }
+        std::vector<int> controllers;
+        for (int mc : traffic_.memory_controllers) {
+            if (isDestination(mc)) {
+                controllers.push_back(mc);
+            }
+        }
+        if (controllers.empty()) {
+            return false;
         }
+        std::uniform_int_distribution<> dist(0, static_cast<int>(controllers.size()) - 1);
+        int dest_id = controllers[dist(rng_)];
+        packet = Packet(id_, dest_id, Packet::CONTROL, payload_distribution_(rng_), current_time_);
+        packet.setMessageClass(Packet::REQUEST_CLASS);
+        packet.setTrafficClass(generate_traffic_class());
+        packet.setSizeBytes(generate_packet_size());
+        packet.setId(allocate_packet_id(dest_id));
+        outstanding_requests_[packet.getId()] = current_time_;
+        requests_sent_++;
+        return true;
+    }
+
+    // Tratar pedidos (no controlador de memória) e respostas (no nó que pediu)
+    void handle_protocol_packet(const Packet& packet) {
+        if (memory_controller_ && packet.getType() == Packet::CONTROL) {
+            PendingReply reply;
+            reply.dst_id = packet.getSrcId();
+            reply.request_id = packet.getId();
+            reply.payload = packet.getPayload();
+            reply.traffic_class = packet.getTrafficClass();
+            reply.ready_time = current_time_ + traffic_.service_time;
+            pending_replies_.push_back(reply);
+            requests_served_++;
+            return;
+        }
+        
+        if (packet.getMessageClass() != Packet::REPLY_CLASS) {
+            return;
+        }
+        
+        auto it = outstanding_requests_.find(packet.getRequestId());
+        if (it == outstanding_requests_.end()) {
+            std::cout << "Node " << id_ << " protocol error: reply without request " << packet
+                      << " at time " << current_time_ << std::endl;
+            return;
+        }
+        
+        int round_trip = current_time_ - it->second;
+        outstanding_requests_.erase(it);
+        replies_received_++;
+        total_round_trip_ += round_trip;
+        if (round_trip > max_round_trip_) {
+            max_round_trip_ = round_trip;
+        }
+    }
+
+    // Montar um pacote multicast para multicast_fanout destinos sorteados entre
+    // os nós ativos (todos no broadcast). Emulado por unicasts, vira uma cópia
+    // por destino com o mesmo ID, e as demais esperam em unicast_copies_
+    bool generate_multicast(Packet& packet) {
+        std::vector<int> candidates;
+        for (int node_id = 0; node_id < total_nodes_; node_id++) {
+            if (node_id != id_ && isDestination(node_id)) {
+                candidates.push_back(node_id);
+            }
+        }
+        if (candidates.empty()) {
+            return false;
+        }
+        size_t fanout = static_cast<size_t>(traffic_.multicast_fanout);
+        if (fanout > 0 && fanout < candidates.size()) {
+            // Embaralhar só as primeiras posições (Fisher-Yates parcial)
+            for (size_t k = 0; k < fanout; k++) {
+                std::uniform_int_distribution<size_t> dist(k, candidates.size() - 1);
+                std::swap(candidates[k], candidates[dist(rng_)]);
+            }
+            candidates.resize(fanout);
+        }
+        DestinationSet destinations;
+        for (int node_id : candidates) {
+            destinations.add(node_id);
+        }
+        
+        packet = Packet(id_, destinations.first(), Packet::DATA, payload_distribution_(rng_), current_time_);
+        packet.setTrafficClass(generate_traffic_class());
+        packet.setSizeBytes(generate_packet_size());
+        packet.setId(scoreboard_ ? scoreboard_->registerMulticast(destinations)
+                                 : (static_cast<long long>(id_) << 40) | next_local_id_++);
+        multicasts_sent_++;
+        multicast_destinations_ += destinations.count();
+        if (!traffic_.multicast_as_unicast) {
+            packet.setDestinations(destinations);
+            return true;
+        }
+        
+        for (int node_id : destinations.members()) {
+            DestinationSet single;
+            single.add(node_id);
+            Packet copy = packet;
+            copy.setDestinations(single);
+            unicast_copies_.push_back(copy);
+        }
+        packet = unicast_copies_.front();
+        unicast_copies_.pop_front();
+        return true;
+    }
+
+    // Obter um ID único para um novo pacote
+    long long allocate_packet_id(int dest_id) {
+        if (scoreboard_) {
+            return scoreboard_->registerInjection(dest_id);
+        }
+        // Sem scoreboard: ID do nó nos bits altos e sequência local nos baixos
+        return (static_cast<long long>(id_) << 40) | next_local_id_++;
     }
 
     // Gerar um novo pacote baseado na taxa de injeção
@@ -110,8 +346,57 @@ public:
         return dist(rng_) <= packet_injection_rate_;
     }
 
-    // Gerar um ID de nó de destino aleatório que não seja este nó
+    // Sortear a classe de tráfego de um novo pacote conforme a mistura configurada
+    int generate_traffic_class() {
+        if (traffic_.class_mix.size() <= 1) {
+            return 0;
+        }
+        std::uniform_int_distribution<> dist(1, 100);
+        int draw = dist(rng_);
+        int cumulative = 0;
+        for (size_t c = 0; c < traffic_.class_mix.size(); c++) {
+            cumulative += traffic_.class_mix[c];
+            if (draw <= cumulative) {
+                return static_cast<int>(c);
+            }
+        }
+        return 0;
+    }
+
+    // Sortear o tamanho em bytes de um novo pacote conforme a mistura configurada
+    int generate_packet_size() {
+        if (traffic_.packet_sizes.empty()) {
+            return Packet::SIZE_BYTES;
+        }
+        std::uniform_int_distribution<> dist(1, 100);
+        int draw = dist(rng_);
+        int cumulative = 0;
+        for (const auto& size : traffic_.packet_sizes) {
+            cumulative += size.second;
+            if (draw <= cumulative) {
+                return size.first;
+            }
+        }
+        return traffic_.packet_sizes.back().first;
+    }
+
+    // Gerar um ID de nó de destino aleatório que não seja este nó, entre os
+    // nós ativos se houver lista de destinos (-1 se não houver nenhum)
     int generate_destination() {
+        if (destinations_) {
+            int count = static_cast<int>(destinations_->size());
+            bool self_listed = isDestination(id_);
+            if (count - (self_listed ? 1 : 0) < 1) {
+                return -1;
+            }
+            std::uniform_int_distribution<> dist(0, count - 1);
+            int dest;
+            do {
+                dest = (*destinations_)[dist(rng_)];
+            } while (dest == id_);
+            return dest;
+        }
+        
         std::uniform_int_distribution<> dist(0, total_nodes_ - 1);
         int dest;
         do {
@@ -120,10 +405,201 @@ public:
         return dest;
     }
 
+    // Usar um scoreboard compartilhado para IDs e conferência de entregas
+    void setScoreboard(PacketScoreboard* scoreboard) { scoreboard_ = scoreboard; }
+    
+    // Trace de eventos dos pacotes (nullptr = desligado)
+    void setTrace(EventTraceWriter* trace) { trace_ = trace; }
+    
+    // Restringir os destinos aos nós da lista ordenada (nós ativos após falhas);
+    // nullptr volta a usar todos os nós
+    void setDestinations(const std::vector<int>* destinations) { destinations_ = destinations; }
+    
+    bool isDestination(int node_id) const {
+        return !destinations_ || std::binary_search(destinations_->begin(), destinations_->end(), node_id);
+    }
+    
+    // Medir o tempo em ciclos do clock de referência (nó em outro domínio de clock)
+    void setReferencePeriod(const sc_time& period) { reference_period_ = period; }
+    
+    // Configurar taxa de injeção, fim da geração de pacotes e semente do
+    // gerador aleatório (combinada com o ID, cada nó tem sua sequência)
+    void setInjectionRate(int packet_injection_rate) { packet_injection_rate_ = packet_injection_rate; }
+    void setSimulationTime(int simulation_time) { simulation_time_ = simulation_time; }
+    
+    void setSeed(unsigned seed) {
+        std::seed_seq sequence{seed, static_cast<unsigned>(id_)};
+        rng_.seed(sequence);
+        payload_distribution_.reset();
+    }
+    
+    // Voltar ao estado da construção para uma nova execução: sem pacotes,
+    // contadores e pedidos pendentes, ativo e com todos os nós como destino.
+    // O tempo recomeça em time_origin, a próxima borda de subida do clock.
+    void reset(const sc_time& time_origin) {
+        resetStatistics();
+        current_time_ = 0;
+        time_origin_ = time_origin;
+        next_local_id_ = 0;
+        enabled_ = true;
+        paused_ = false;
+        destinations_ = nullptr;
+        pending_replies_.clear();
+        outstanding_requests_.clear();
+        unicast_copies_.clear();
+    }
+    
+    // Zerar contadores e histogramas mantendo o estado do tráfego (pedidos
+    // pendentes, cópias de multicast, gerador): as estatísticas de uma
+    // execução restaurada de um checkpoint começam no ciclo restaurado
+    void resetStatistics() {
+        packets_sent_ = 0;
+        packets_received_ = 0;
+        total_latency_ = 0;
+        total_hops_ = 0;
+        total_deflections_ = 0;
+        bytes_sent_ = 0;
+        bytes_received_ = 0;
+        requests_sent_ = 0;
+        replies_received_ = 0;
+        requests_served_ = 0;
+        total_round_trip_ = 0;
+        max_round_trip_ = 0;
+        for (LatencyHistogram& latency : class_latency_) {
+            latency = LatencyHistogram();
+        }
+        multicasts_sent_ = 0;
+        multicast_destinations_ = 0;
+        multicast_injections_ = 0;
+        multicast_latency_ = LatencyHistogram();
+        multicast_completion_ = LatencyHistogram();
+    }
+    
+    // Desativar o nó (tile desativado): não injeta mais pacotes
+    void disable() { enabled_ = false; }
+    bool isEnabled() const { return enabled_; }
+    
+    // Suspender a injeção enquanto a rede esvazia para trocar o roteamento
+    void setPaused(bool paused) { paused_ = paused; }
+    
+    // Configurar o modo de tráfego (antes de iniciar a simulação)
+    void setTraffic(const TrafficConfig& traffic) {
+        traffic_ = traffic;
+        memory_controller_ = traffic.isMemoryController(id_);
+    }
+    
+    // Adicionar à lista o ID do pacote oferecido ao router e ainda não
+    // aceito e os das cópias unicast de multicast ainda por enviar
+    void collectInFlightIds(std::vector<long long>& ids) const {
+        if (out_valid.read()) {
+            ids.push_back(out_packet.read().getId());
+        }
+        for (const Packet& copy : unicast_copies_) {
+            ids.push_back(copy.getId());
+        }
+    }
+
+    // Gravar e restaurar contadores, pacotes em serviço ou pendentes e o
+    // estado do gerador aleatório (checkpoint)
+    void saveState(CheckpointWriter& out) const {
+        out.writeInt(current_time_);
+        out.writeInt(packets_sent_);
+        out.writeInt(packets_received_);
+        out.writeInt(total_latency_);
+        out.writeInt(total_hops_);
+        out.writeInt(total_deflections_);
+        out.writeInt(bytes_sent_);
+        out.writeInt(bytes_received_);
+        out.writeInt(next_local_id_);
+        for (const LatencyHistogram& latency : class_latency_) {
+            latency.saveState(out);
+        }
+        out.writeRng(rng_);
+        
+        out.writeInt(requests_sent_);
+        out.writeInt(replies_received_);
+        out.writeInt(requests_served_);
+        out.writeInt(total_round_trip_);
+        out.writeInt(max_round_trip_);
+        out.writeUnsigned(pending_replies_.size());
+        for (const PendingReply& reply : pending_replies_) {
+            out.writeInt(reply.dst_id);
+            out.writeInt(reply.request_id);
+            out.writeInt(reply.payload);
+            out.writeInt(reply.traffic_class);
+            out.writeInt(reply.ready_time);
+        }
+        // Em ordem de ID, para que o arquivo não dependa da tabela hash
+        std::vector<std::pair<long long, int>> outstanding(outstanding_requests_.begin(), outstanding_requests_.end());
+        std::sort(outstanding.begin(), outstanding.end());
+        out.writeUnsigned(outstanding.size());
+        for (const auto& request : outstanding) {
+            out.writeInt(request.first);
+            out.writeInt(request.second);
+        }
+        
+        out.writeUnsigned(unicast_copies_.size());
+        for (const Packet& copy : unicast_copies_) {
+            copy.saveState(out);
+        }
+        out.writeInt(multicasts_sent_);
+        out.writeInt(multicast_destinations_);
+        out.writeInt(multicast_injections_);
+        multicast_latency_.saveState(out);
+        multicast_completion_.saveState(out);
+    }
+    
+    void loadState(CheckpointReader& in) {
+        current_time_ = static_cast<int>(in.readInt());
+        packets_sent_ = static_cast<int>(in.readInt());
+        packets_received_ = static_cast<int>(in.readInt());
+        total_latency_ = static_cast<int>(in.readInt());
+        total_hops_ = static_cast<int>(in.readInt());
+        total_deflections_ = in.readInt();
+        bytes_sent_ = in.readInt();
+        bytes_received_ = in.readInt();
+        next_local_id_ = in.readInt();
+        for (LatencyHistogram& latency : class_latency_) {
+            latency.loadState(in);
+        }
+        in.readRng(rng_);
+        
+        requests_sent_ = static_cast<int>(in.readInt());
+        replies_received_ = static_cast<int>(in.readInt());
+        requests_served_ = static_cast<int>(in.readInt());
+        total_round_trip_ = in.readInt();
+        max_round_trip_ = static_cast<int>(in.readInt());
+        pending_replies_.assign(in.readSize(), PendingReply());
+        for (PendingReply& reply : pending_replies_) {
+            reply.dst_id = static_cast<int>(in.readInt());
+            reply.request_id = in.readInt();
+            reply.payload = static_cast<int>(in.readInt());
+            reply.traffic_class = static_cast<int>(in.readInt());
+            reply.ready_time = static_cast<int>(in.readInt());
+        }
+        outstanding_requests_.clear();
+        size_t outstanding = in.readSize();
+        for (size_t k = 0; k < outstanding && in.ok(); k++) {
+            long long id = in.readInt();
+            outstanding_requests_[id] = static_cast<int>(in.readInt());
+        }
+        
+        unicast_copies_.assign(in.readSize(), Packet());
+        for (Packet& copy : unicast_copies_) {
+            copy.loadState(in);
+        }
+        multicasts_sent_ = in.readInt();
+        multicast_destinations_ = in.readInt();
+        multicast_injections_ = in.readInt();
+        multicast_latency_.loadState(in);
+        multicast_completion_.loadState(in);
+    }
+
     // Obter estatísticas do nó
     int getId() const { return id_; }
     int getPacketsSent() const { return packets_sent_; }
     int getPacketsReceived() const { return packets_received_; }
+    long long getTotalLatency() const { return total_latency_; }
     
     // Obter latência média e saltos médios
     double getAverageLatency() const {
@@ -133,6 +609,42 @@ public:
     double getAverageHops() const {
         return packets_received_ > 0 ? static_cast<double>(total_hops_) / packets_received_ : 0.0;
     }
+    
+    // Desvios somados dos pacotes recebidos (routers sem buffers)
+    long long getTotalDeflections() const { return total_deflections_; }
+    
+    // Bytes somados dos pacotes enviados e recebidos
+    long long getBytesSent() const { return bytes_sent_; }
+    long long getBytesReceived() const { return bytes_received_; }
+    
+    // Latências dos pacotes recebidos de uma classe de tráfego
+    const LatencyHistogram& getClassLatency(int traffic_class) const {
+        return class_latency_[traffic_class];
+    }
+    
+    // Estatísticas do tráfego pedido-resposta
+    bool isMemoryController() const { return memory_controller_; }
+    int getRequestsSent() const { return requests_sent_; }
+    int getRepliesReceived() const { return replies_received_; }
+    int getRequestsServed() const { return requests_served_; }
+    int getOutstandingRequests() const { return static_cast<int>(outstanding_requests_.size()); }
+    int getPendingReplies() const { return static_cast<int>(pending_replies_.size()); }
+    long long getTotalRoundTrip() const { return total_round_trip_; }
+    int getMaxRoundTrip() const { return max_round_trip_; }
+    
+    double getAverageRoundTrip() const {
+        return replies_received_ > 0 ? static_cast<double>(total_round_trip_) / replies_received_ : 0.0;
+    }
+    
+    // Estatísticas do multicast: pacotes gerados, destinos somados, pacotes
+    // injetados (um por multicast na árvore, um por destino emulado),
+    // latência até cada destino recebido aqui e até o último destino dos
+    // multicasts concluídos neste nó
+    long long getMulticastsSent() const { return multicasts_sent_; }
+    long long getMulticastDestinations() const { return multicast_destinations_; }
+    long long getMulticastInjections() const { return multicast_injections_; }
+    const LatencyHistogram& getMulticastLatency() const { return multicast_latency_; }
+    const LatencyHistogram& getMulticastCompletion() const { return multicast_completion_; }
 
 private:
     int id_;                     // ID do nó
@@ -142,10 +654,49 @@ private:
     int packets_sent_;           // Número de pacotes enviados
     int packets_received_;       // Número de pacotes recebidos
     int current_time_;           // Tempo atual da simulação
+    sc_time reference_period_;   // Período do clock de referência (zero = contar ciclos do próprio clock)
+    sc_time time_origin_;        // Instante do ciclo 1 da execução atual (clock de referência)
     int total_latency_ = 0;      // Soma das latências dos pacotes
     int total_hops_ = 0;         // Soma dos saltos dos pacotes
+    long long total_deflections_ = 0;  // Soma dos desvios dos pacotes
+    long long bytes_sent_ = 0;         // Soma dos tamanhos dos pacotes enviados
+    long long bytes_received_ = 0;     // Soma dos tamanhos dos pacotes recebidos
+    long long next_local_id_;    // Contador de IDs quando não há scoreboard
+    PacketScoreboard* scoreboard_;  // Scoreboard da rede (opcional)
+    EventTraceWriter* trace_;    // Trace de eventos (opcional)
+    bool enabled_;               // Nó ativo (falso se o router falhou)
+    bool paused_;                // Injeção suspensa durante a troca do roteamento
+    const std::vector<int>* destinations_;  // Destinos permitidos (nullptr = todos)
+    
+    // Resposta aguardando o fim do tempo de serviço no controlador de memória
+    struct PendingReply {
+        int dst_id;
+        long long request_id;
+        int payload;
+        int traffic_class;
+        int ready_time;
+    };
+    
+    TrafficConfig traffic_;      // Modo de tráfego
+    bool memory_controller_;     // Este nó atende pedidos
+    std::deque<PendingReply> pending_replies_;  // Respostas em serviço, em ordem de chegada
+    std::unordered_map<long long, int> outstanding_requests_;  // Pedido pendente -> ciclo de emissão
+    int requests_sent_;          // Pedidos emitidos
+    int replies_received_;       // Respostas recebidas
+    int requests_served_;        // Pedidos recebidos (controlador de memória)
+    long long total_round_trip_; // Soma das latências de ida e volta
+    int max_round_trip_;         // Maior latência de ida e volta
+    LatencyHistogram class_latency_[Packet::NUM_TRAFFIC_CLASSES];  // Latências por classe de tráfego
+    
+    std::deque<Packet> unicast_copies_;  // Cópias de multicast emulado ainda por enviar
+    long long multicasts_sent_;          // Multicasts gerados
+    long long multicast_destinations_;   // Destinos somados dos multicasts gerados
+    long long multicast_injections_;     // Pacotes multicast injetados na rede
+    LatencyHistogram multicast_latency_;     // Latência de cada entrega multicast
+    LatencyHistogram multicast_completion_;  // Latência até o último destino
     
     std::mt19937 rng_;           // Gerador de números aleatórios
+    std::uniform_int_distribution<int> payload_distribution_{0, 999};  // Carga útil dos pacotes
 };
 
 #endif // NODE_H
\ No newline at end of file
@@ -2,8 +2,93 @@
 #define PACKET_H
 
 #include <systemc.h>
+#include <cstdint>
 #include <string>
 #include <iostream>
+#include <vector>
+#include "checkpoint.h"
+
+// Conjunto de nós de destino de um pacote multicast, um bit por nó. Vazio
+// em pacotes unicast, que não pagam pela cópia dos bits
+class DestinationSet {
+public:
+    bool empty() const { return words_.empty(); }
+
+    void add(int node_id) {
+        size_t word = static_cast<size_t>(node_id) / 64;
+        if (word >= words_.size()) {
+            words_.resize(word + 1, 0);
+        }
+        words_[word] |= uint64_t(1) << (node_id % 64);
+    }
+
+    void remove(int node_id) {
+        size_t word = static_cast<size_t>(node_id) / 64;
+        if (word < words_.size()) {
+            words_[word] &= ~(uint64_t(1) << (node_id % 64));
+            trim();
+        }
+    }
+
+    bool contains(int node_id) const {
+        size_t word = static_cast<size_t>(node_id) / 64;
+        return node_id >= 0 && word < words_.size() && (words_[word] >> (node_id % 64)) & 1;
+    }
+
+    // Menor nó do conjunto (-1 se vazio)
+    int first() const {
+        for (size_t w = 0; w < words_.size(); w++) {
+            for (int b = 0; b < 64; b++) {
+                if ((words_[w] >> b) & 1) {
+                    return static_cast<int>(w * 64) + b;
+                }
+            }
+        }
+        return -1;
+    }
+
+    int count() const {
+        int total = 0;
+        for (uint64_t word : words_) {
+            for (; word != 0; word &= word - 1) {
+                total++;
+            }
+        }
+        return total;
+    }
+
+    // Nós do conjunto em ordem crescente
+    std::vector<int> members() const {
+        std::vector<int> nodes;
+        for (size_t w = 0; w < words_.size(); w++) {
+            for (int b = 0; b < 64; b++) {
+                if ((words_[w] >> b) & 1) {
+                    nodes.push_back(static_cast<int>(w * 64) + b);
+                }
+            }
+        }
+        return nodes;
+    }
+
+    bool operator==(const DestinationSet& other) const { return words_ == other.words_; }
+
+    void saveState(CheckpointWriter& out) const { out.writeUnsigneds(words_); }
+
+    void loadState(CheckpointReader& in) {
+        words_ = in.readUnsigneds();
+        trim();
+    }
+
+private:
+    std::vector<uint64_t> words_;  // Bit n da palavra w: nó 64 * w + n
+
+    // Sem palavras nulas no fim: o conjunto vazio não guarda memória
+    void trim() {
+        while (!words_.empty() && words_.back() == 0) {
+            words_.pop_back();
+        }
+    }
+};
 
 // Definição da classe Packet para comunicação NoC
 class Packet {
@@ -14,6 +99,34 @@ public:
         CONTROL
     };
 
+    // Classes de mensagem: cada classe tem buffers e créditos próprios nos
+    // routers e enlaces, então respostas nunca esperam atrás de pedidos
+    enum MessageClass {
+        REQUEST_CLASS,
+        REPLY_CLASS
+    };
+    static const int NUM_MESSAGE_CLASSES = 2;
+
+    // Sinais de pronto carregam uma máscara com um bit por classe
+    static constexpr int ALL_CLASSES_MASK = (1 << NUM_MESSAGE_CLASSES) - 1;
+    static int classMask(int message_class) { return 1 << message_class; }
+
+    // Sinais de crédito carregam uma contagem de 8 bits por classe
+    static int classCount(int message_class, int count) { return count << (8 * message_class); }
+    static int countOfClass(int counts, int message_class) { return (counts >> (8 * message_class)) & 0xFF; }
+
+    static const char* messageClassName(int message_class) {
+        return message_class == REPLY_CLASS ? "REPLY" : "REQUEST";
+    }
+
+    // Classes de tráfego (QoS): 0 é a menos prioritária
+    static const int NUM_TRAFFIC_CLASSES = 4;
+
+    // Tamanho padrão do pacote no enlace: origem, destino, tipo e carga útil
+    // (4 bytes cada); o tráfego pode sortear outros tamanhos até MAX_SIZE_BYTES
+    static const int SIZE_BYTES = 16;
+    static const int MAX_SIZE_BYTES = 4096;
+
     // Construtor
     Packet(int src_id = -1, int dst_id = -1, PacketType type = DATA, 
            int payload = 0, int timestamp = 0) : 
@@ -23,7 +136,13 @@ public:
         payload_(payload),
         timestamp_(timestamp),
         hops_(0),
-        creation_time_(timestamp) {}
+        creation_time_(timestamp),
+        id_(-1),
+        message_class_(REQUEST_CLASS),
+        request_id_(-1),
+        traffic_class_(0),
+        deflections_(0),
+        size_bytes_(SIZE_BYTES) {}
 
     // Construtor de cópia
     Packet(const Packet& other) :
@@ -34,6 +153,13 @@ public:
         timestamp_(other.timestamp_),
         hops_(other.hops_),
         creation_time_(other.creation_time_),
+        id_(other.id_),
+        message_class_(other.message_class_),
+        request_id_(other.request_id_),
+        traffic_class_(other.traffic_class_),
+        deflections_(other.deflections_),
+        size_bytes_(other.size_bytes_),
+        destinations_(other.destinations_),
         route_path_(other.route_path_) {}
 
     // Getters (métodos de acesso)
@@ -44,7 +170,23 @@ public:
     int getTimestamp() const { return timestamp_; }
     int getHops() const { return hops_; }
     int getCreationTime() const { return creation_time_; }
+    long long getId() const { return id_; }
+    MessageClass getMessageClass() const { return message_class_; }
+    long long getRequestId() const { return request_id_; }
+    int getTrafficClass() const { return traffic_class_; }
+    int getDeflections() const { return deflections_; }
     std::string getRoutePath() const { return route_path_; }
+    int getSizeBytes() const { return size_bytes_; }
+
+    // Multicast: o pacote segue para todos os nós de getDestinations(), e
+    // dst_id_ é o menor deles, usado pelo roteamento, trace e watchdog
+    bool isMulticast() const { return !destinations_.empty(); }
+    const DestinationSet& getDestinations() const { return destinations_; }
+
+    void setDestinations(const DestinationSet& destinations) {
+        destinations_ = destinations;
+        dst_id_ = destinations_.first();
+    }
 
     // Setters (métodos de modificação)
     void setSrcId(int src_id) { src_id_ = src_id; }
@@ -52,10 +194,18 @@ public:
     void setType(PacketType type) { type_ = type; }
     void setPayload(int payload) { payload_ = payload; }
     void setTimestamp(int timestamp) { timestamp_ = timestamp; }
+    void setId(long long id) { id_ = id; }
+    void setMessageClass(MessageClass message_class) { message_class_ = message_class; }
+    void setRequestId(long long request_id) { request_id_ = request_id; }
+    void setTrafficClass(int traffic_class) { traffic_class_ = traffic_class; }
+    void setSizeBytes(int size_bytes) { size_bytes_ = size_bytes; }
 
     // Incrementar contador de saltos quando o pacote passa por um roteador
     void incrementHops() { hops_++; }
 
+    // Incrementar contador de desvios quando um router sem buffers o envia por uma porta não produtiva
+    void incrementDeflections() { deflections_++; }
+
     // Adicionar ID do nó ao caminho da rota
     void addToPath(int node_id) {
         if (!route_path_.empty()) {
@@ -64,6 +214,51 @@ public:
         route_path_ += std::to_string(node_id);
     }
 
+    // Gravar e restaurar todos os campos (checkpoint)
+    void saveState(CheckpointWriter& out) const {
+        out.writeInt(src_id_);
+        out.writeInt(dst_id_);
+        out.writeInt(type_);
+        out.writeInt(payload_);
+        out.writeInt(timestamp_);
+        out.writeInt(hops_);
+        out.writeInt(creation_time_);
+        out.writeInt(id_);
+        out.writeInt(message_class_);
+        out.writeInt(request_id_);
+        out.writeInt(traffic_class_);
+        out.writeInt(deflections_);
+        out.writeInt(size_bytes_);
+        destinations_.saveState(out);
+        out.writeString(route_path_);
+    }
+
+    void loadState(CheckpointReader& in) {
+        src_id_ = static_cast<int>(in.readInt());
+        dst_id_ = static_cast<int>(in.readInt());
+        type_ = static_cast<PacketType>(in.readInt());
+        payload_ = static_cast<int>(in.readInt());
+        timestamp_ = static_cast<int>(in.readInt());
+        hops_ = static_cast<int>(in.readInt());
+        creation_time_ = static_cast<int>(in.readInt());
+        id_ = in.readInt();
+        message_class_ = static_cast<MessageClass>(in.readInt());
+        request_id_ = in.readInt();
+        traffic_class_ = static_cast<int>(in.readInt());
+        deflections_ = static_cast<int>(in.readInt());
+        size_bytes_ = static_cast<int>(in.readInt());
+        destinations_.loadState(in);
+        route_path_ = in.readString();
+        if (message_class_ < 0 || message_class_ >= NUM_MESSAGE_CLASSES ||
+            traffic_class_ < 0 || traffic_class_ >= NUM_TRAFFIC_CLASSES ||
+            size_bytes_ < 1 || size_bytes_ > MAX_SIZE_BYTES) {
+            in.fail();
+            message_class_ = REQUEST_CLASS;
+            traffic_class_ = 0;
+            size_bytes_ = SIZE_BYTES;
+        }
+    }
+
     // Calcular latência
     int getLatency(int current_time) const {
         return current_time - creation_time_;
@@ -71,8 +266,14 @@ public:
 
     // Imprimir informações do pacote
     friend std::ostream& operator<<(std::ostream& os, const Packet& packet) {
-        os << "Packet[" << packet.src_id_ << " -> " << packet.dst_id_ 
+        os << "Packet[" << packet.src_id_ << " -> " << packet.dst_id_;
+        if (packet.isMulticast()) {
+            os << " (multicast, " << packet.destinations_.count() << " destinations)";
+        }
+        os << ", ID: " << packet.id_
            << ", Type: " << (packet.type_ == DATA ? "DATA" : "CONTROL") 
+           << ", Class: " << messageClassName(packet.message_class_)
+           << ", QoS: " << packet.traffic_class_
            << ", Payload: " << packet.payload_
            << ", Hops: " << packet.hops_
            << ", Path: " << packet.route_path_ << "]";
@@ -81,8 +282,9 @@ public:
 
     // Operadores para compatibilidade com SystemC
     bool operator==(const Packet& other) const {
-        return src_id_ == other.src_id_ && dst_id_ == other.dst_id_ && 
-               payload_ == other.payload_ && timestamp_ == other.timestamp_;
+        return id_ == other.id_ && src_id_ == other.src_id_ && dst_id_ == other.dst_id_ && 
+               payload_ == other.payload_ && timestamp_ == other.timestamp_ &&
+               destinations_ == other.destinations_;
     }
 
     bool operator!=(const Packet& other) const {
@@ -99,6 +301,13 @@ public:
             timestamp_ = other.timestamp_;
             hops_ = other.hops_;
             creation_time_ = other.creation_time_;
+            id_ = other.id_;
+            message_class_ = other.message_class_;
+            request_id_ = other.request_id_;
+            traffic_class_ = other.traffic_class_;
+            deflections_ = other.deflections_;
+            size_bytes_ = other.size_bytes_;
+            destinations_ = other.destinations_;
             route_path_ = other.route_path_;
         }
         return *this;
@@ -112,11 +321,19 @@ private:
     int timestamp_;       // Timestamp atual
     int hops_;            // Número de saltos percorridos
     int creation_time_;   // Tempo quando o pacote foi criado
+    long long id_;        // ID único atribuído na injeção (-1 se não atribuído)
+    MessageClass message_class_;  // Classe de mensagem (rede virtual) do pacote
+    long long request_id_;  // ID do pedido respondido (-1 se não for resposta)
+    int traffic_class_;   // Classe de tráfego (prioridade de QoS)
+    int deflections_;     // Desvios sofridos em routers sem buffers
+    int size_bytes_;      // Tamanho no enlace: flits = ceil(tamanho / largura)
+    DestinationSet destinations_;  // Destinos restantes do multicast (vazio = unicast)
     std::string route_path_; // String representando o caminho percorrido
 };
 
 // Função de trace do SystemC para a classe Packet
 inline void sc_trace(sc_core::sc_trace_file* tf, const Packet& packet, const std::string& name) {
+    sc_trace(tf, packet.getId(), name + "_id");
     sc_trace(tf, packet.getSrcId(), name + "_src_id");
     sc_trace(tf, packet.getDstId(), name + "_dst_id");
     sc_trace(tf, packet.getPayload(), name + "_payload");
@@ -0,0 +1,244 @@
+#ifndef RESULTS_STORE_H
+#define RESULTS_STORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "checkpoint.h"
+
+// Arquivo de resultados das execuções
+//
+// Cada execução completa acrescenta um registro com a configuração (pares
+// nome=valor, que formam a chave), a semente e uma coluna por métrica, na
+// ordem de RunResult::metricNames(). O cabeçalho traz os nomes das métricas.
+// O arquivo só cresce: cada registro é prefixado pelo seu tamanho e gravado
+// de uma vez, então um leitor para no último registro completo, e
+// tools/results_aggregator lê apenas o que foi acrescentado desde a última
+// agregação. Não depende do SystemC.
+struct RunResult {
+    static constexpr const char* FILE_MAGIC = "SimpleNoC results";
+    static const int FILE_VERSION = 1;
+
+    std::vector<std::pair<std::string, std::string>> config;
+    bool seeded;
+    unsigned seed;
+    std::vector<double> metrics;
+
+    RunResult() : seeded(false), seed(0) {}
+
+    // Colunas gravadas pelo simulador (NoC::getRunMetrics preenche nesta ordem)
+    static const std::vector<std::string>& metricNames() {
+        static const std::vector<std::string> names = {
+            "sent", "received", "throughput", "delivery", "avg_latency", "p50_latency",
+            "p95_latency", "p99_latency", "max_latency", "avg_hops", "deflections", "lost",
+            "throughput_bytes"};
+        return names;
+    }
+
+    // Posição de uma métrica em metrics (metricNames().size() se não existir)
+    static size_t metricIndex(const std::string& name) {
+        const std::vector<std::string>& names = metricNames();
+        return static_cast<size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+    }
+
+    // Chave de agrupamento das sementes: "nome=valor" separados por espaço
+    std::string key() const {
+        std::string text;
+        for (const auto& field : config) {
+            if (!text.empty()) {
+                text += " ";
+            }
+            text += field.first + "=" + field.second;
+        }
+        return text;
+    }
+
+    void saveState(CheckpointWriter& out) const {
+        out.writeUnsigned(config.size());
+        for (const auto& field : config) {
+            out.writeString(field.first);
+            out.writeString(field.second);
+        }
+        out.writeBool(seeded);
+        out.writeUnsigned(seed);
+        out.writeUnsigned(metrics.size());
+        for (double value : metrics) {
+            out.writeDouble(value);
+        }
+    }
+
+    void loadState(CheckpointReader& in) {
+        config.resize(in.readSize());
+        for (auto& field : config) {
+            field.first = in.readString();
+            field.second = in.readString();
+        }
+        seeded = in.readBool();
+        seed = static_cast<unsigned>(in.readUnsigned());
+        metrics.resize(in.readSize());
+        for (double& value : metrics) {
+            value = in.readDouble();
+        }
+    }
+};
+
+// Leitura sequencial de um arquivo de resultados
+class ResultsReader {
+public:
+    explicit ResultsReader(std::istream& in) : in_(in), reader_(in), offset_(0) {}
+
+    // Conferir o cabeçalho e ler os nomes das métricas; false se não for um
+    // arquivo de resultados desta versão
+    bool readHeader() {
+        if (reader_.readString() != RunResult::FILE_MAGIC || reader_.readInt() != RunResult::FILE_VERSION) {
+            return false;
+        }
+        metric_names_.resize(reader_.readSize());
+        for (std::string& name : metric_names_) {
+            name = reader_.readString();
+        }
+        offset_ = static_cast<uint64_t>(in_.tellg());
+        return reader_.ok();
+    }
+
+    // Continuar a partir de um deslocamento já lido (registro completo)
+    void seek(uint64_t offset) {
+        in_.clear();
+        in_.seekg(static_cast<std::streamoff>(offset));
+        offset_ = offset;
+    }
+
+    // Próximo registro; false no fim do arquivo ou em registro incompleto
+    // (gravação em andamento), sem avançar o deslocamento
+    bool next(RunResult& result) {
+        if (in_.peek() == std::char_traits<char>::eof()) {
+            return false;
+        }
+        uint64_t size = reader_.readUnsigned();
+        if (!reader_.ok() || size > MAX_RECORD) {
+            return false;
+        }
+        std::string payload(static_cast<size_t>(size), '\0');
+        in_.read(&payload[0], static_cast<std::streamsize>(size));
+        if (!in_) {
+            return false;
+        }
+        std::istringstream record(payload);
+        CheckpointReader fields(record);
+        result.loadState(fields);
+        if (!fields.ok() || result.metrics.size() != metric_names_.size()) {
+            corrupt_ = true;
+            return false;
+        }
+        offset_ = static_cast<uint64_t>(in_.tellg());
+        return true;
+    }
+
+    const std::vector<std::string>& getMetricNames() const { return metric_names_; }
+    uint64_t getOffset() const { return offset_; }
+    bool isCorrupt() const { return corrupt_; }
+
+private:
+    static const uint64_t MAX_RECORD = 1u << 20;
+
+    std::istream& in_;
+    CheckpointReader reader_;
+    std::vector<std::string> metric_names_;
+    uint64_t offset_;   // Fim do último registro completo
+    bool corrupt_ = false;
+};
+
+// Criar filename só com o cabeçalho, se ainda não existir. O cabeçalho é
+// gravado em um arquivo temporário e ligado ao nome final, o que cria o
+// arquivo de forma exclusiva e atômica: execuções paralelas sobre um arquivo
+// novo gravam um único cabeçalho e nenhuma o vê pela metade
+inline bool createResultsFile(const std::string& filename, std::string& error) {
+    std::error_code code;
+    if (std::filesystem::exists(filename, code)) {
+        return true;
+    }
+
+    std::string temporary = filename + ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            error = "não foi possível criar " + temporary;
+            return false;
+        }
+        CheckpointWriter out(file);
+        out.writeString(RunResult::FILE_MAGIC);
+        out.writeInt(RunResult::FILE_VERSION);
+        out.writeUnsigned(RunResult::metricNames().size());
+        for (const std::string& name : RunResult::metricNames()) {
+            out.writeString(name);
+        }
+        file.flush();
+        if (!file) {
+            std::filesystem::remove(temporary, code);
+            error = "falha ao gravar " + temporary;
+            return false;
+        }
+    }
+
+    // Outra execução pode ter criado o arquivo desde a verificação acima
+    std::error_code link_code;
+    std::filesystem::create_hard_link(temporary, filename, link_code);
+    std::filesystem::remove(temporary, code);
+    if (link_code && !std::filesystem::exists(filename, code)) {
+        error = "não foi possível criar " + filename + ": " + link_code.message();
+        return false;
+    }
+    return true;
+}
+
+// Acrescentar o resultado de uma execução a filename, criando o arquivo com o
+// cabeçalho se ainda não existir; as métricas de um arquivo existente devem
+// ser as desta versão do simulador
+inline bool appendRunResult(const std::string& filename, const RunResult& result, std::string& error) {
+    if (!createResultsFile(filename, error)) {
+        return false;
+    }
+    {
+        std::ifstream existing(filename, std::ios::binary);
+        ResultsReader reader(existing);
+        if (!existing || !reader.readHeader()) {
+            error = filename + " não é um arquivo de resultados desta versão";
+            return false;
+        }
+        if (reader.getMetricNames() != RunResult::metricNames()) {
+            error = filename + " tem outras colunas de métricas; use outro arquivo";
+            return false;
+        }
+    }
+
+    std::ostringstream record;
+    CheckpointWriter fields(record);
+    result.saveState(fields);
+    std::ostringstream buffer;
+    CheckpointWriter out(buffer);
+    out.writeString(record.str());
+
+    // Uma única escrita no fim do arquivo: execuções paralelas não intercalam registros
+    std::ofstream file(filename, std::ios::binary | std::ios::app);
+    if (!file) {
+        error = "não foi possível abrir " + filename;
+        return false;
+    }
+    const std::string bytes = buffer.str();
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    file.flush();
+    if (!file) {
+        error = "falha ao gravar " + filename;
+        return false;
+    }
+    return true;
+}
+
+#endif // RESULTS_STORE_H
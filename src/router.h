@@ -7,9 +7,15 @@
 #include <memory>
 #include "packet.h"
 #include "routing_algorithms.h"
+#include "arbitration.h"
+#include "router_stats.h"
+#include "scoreboard.h"
+#include "checkpoint.h"
+#include "event_trace.h"
 
-// Router para Network-on-Chip
-class Router : public sc_module {
+// Interface comum dos routers da malha: portas, posição e consultas usadas
+// pelo NoC (watchdog, scoreboard e estatísticas)
+class BaseRouter : public sc_module {
 public:
     // Portas
     sc_in<bool> clk;
@@ -17,125 +23,679 @@ public:
     // Portas de entrada dos canais (NORTE, LESTE, SUL, OESTE, LOCAL)
     sc_in<Packet> in_packets[5];
     sc_in<bool> in_valids[5];
-    sc_out<bool> in_readys[5];
+    sc_out<int> in_readys[5];      // Máscara de classes com espaço no buffer
     
     // Portas de saída para os canais (NORTE, LESTE, SUL, OESTE, LOCAL)
     sc_out<Packet> out_packets[5];
     sc_out<bool> out_valids[5];
-    sc_in<bool> out_readys[5];
+    sc_in<int> out_readys[5];      // Máscara de classes aceitas pelo destino
 
-    // Construtor
-    Router(sc_module_name name, int x, int y, int mesh_size_x, int mesh_size_y, 
-           RoutingAlgorithm* routing_algorithm) : 
+    BaseRouter(sc_module_name name, int x, int y, int mesh_size_x, int mesh_size_y,
+               RoutingAlgorithm* routing_algorithm) :
         sc_module(name),
         x_(x),
         y_(y),
         mesh_size_x_(mesh_size_x),
         mesh_size_y_(mesh_size_y),
-        routing_algorithm_(routing_algorithm) {
+        routing_algorithm_(routing_algorithm),
+        packets_forwarded_(0),
+        packets_discarded_(0),
+        failed_(false),
+        draining_(false),
+        scoreboard_(nullptr),
+        trace_(nullptr) {
+        for (int port = 0; port < 5; port++) {
+            port_failed_[port] = false;
+            link_widths_[port] = 0;
+            credit_signals_[port] = nullptr;
+        }
+    }
+
+    virtual ~BaseRouter() {}
+
+    // Obter coordenadas do router
+    int getX() const { return x_; }
+    int getY() const { return y_; }
+    
+    // Obter ID do nó
+    int getNodeId() const { return y_ * mesh_size_x_ + x_; }
+    
+    // Obter nome do algoritmo de roteamento
+    std::string getRoutingAlgorithmName() const {
+        return routing_algorithm_->getName();
+    }
+    
+    // Trocar o algoritmo de roteamento (o router assume a posse)
+    void setRoutingAlgorithm(RoutingAlgorithm* routing_algorithm) {
+        routing_algorithm_.reset(routing_algorithm);
+    }
+
+    // Trocar a política de arbitragem das saídas (o router assume a posse)
+    virtual void setArbiter(Arbiter* arbiter) = 0;
+    virtual std::string getArbiterName() const = 0;
+
+    // Estado dos buffers de entrada por classe, usado pelo watchdog de deadlock
+    virtual int getBufferOccupancy(int input_port, int message_class) const = 0;
+    
+    // Pacote na cabeça do buffer de entrada da classe (nullptr se vazio)
+    virtual const Packet* getHeadPacket(int input_port, int message_class) const = 0;
+    
+    // Porta de saída pedida pelo pacote na cabeça do buffer de entrada (NONE se vazio)
+    int getHeadOutputPort(int input_port, int message_class) const {
+        const Packet* head = getHeadPacket(input_port, message_class);
+        if (!head) {
+            return NONE;
+        }
+        return routing_algorithm_->calculateOutputPort(
+            x_, y_, head->getDstId() % mesh_size_x_, head->getDstId() / mesh_size_x_);
+    }
+    
+    // Adicionar à lista os IDs dos pacotes retidos no router
+    virtual void collectInFlightIds(std::vector<long long>& ids) const = 0;
+    
+    // Total de pacotes encaminhados (medida de progresso)
+    long long getPacketsForwarded() const { return packets_forwarded_; }
+    
+    // Injeção de falhas: o enlace da porta deixa de ser usado nos dois sentidos
+    void setPortFailed(int port) { port_failed_[port] = true; }
+    bool isPortFailed(int port) const { return port_failed_[port]; }
+    
+    // Router desativado: passa a aceitar e descartar tudo o que chega, para
+    // que nenhum vizinho fique preso esperando por ele
+    void setFailed() {
+        failed_ = true;
+        for (int port = 0; port < 5; port++) {
+            port_failed_[port] = true;
+        }
+    }
+    bool isFailed() const { return failed_; }
+    
+    // Esvaziamento antes da troca das tabelas de roteamento: pacotes cuja rota
+    // antiga usa um enlace rompido são descartados em vez de esperar por ele
+    void setDraining(bool draining) { draining_ = draining; }
+    
+    // Pacotes descartados por falha ou destino inalcançável
+    long long getPacketsDiscarded() const { return packets_discarded_; }
+    
+    // Scoreboard da rede, avisado dos pacotes descartados (opcional)
+    void setScoreboard(PacketScoreboard* scoreboard) { scoreboard_ = scoreboard; }
+    
+    // Trace de eventos dos pacotes (nullptr = desligado)
+    void setTrace(EventTraceWriter* trace) { trace_ = trace; }
+    
+    // Largura em bytes do Channel ligado à saída (0 = sinais diretos, pacote
+    // inteiro em um ciclo), para contar os ciclos de ocupação do enlace
+    void setLinkWidth(int port, int width) { link_widths_[port] = width; }
+    
+    // Sinal pelo qual a entrada devolve ao Channel que a alimenta as vagas
+    // liberadas no buffer (nullptr = sinais diretos, sem créditos)
+    void setCreditSignal(int port, sc_signal<int>* signal) { credit_signals_[port] = signal; }
+
+#ifdef NOC_ROUTER_STATS
+    // Obter contadores acumulados do router
+    const RouterCounters& getCounters() const { return counters_; }
+#endif
+
+    // Voltar ao estado da construção: sem pacotes, contadores e falhas
+    // (reinício da rede para uma nova execução)
+    virtual void reset() {
+        resetStatistics();
+        failed_ = false;
+        draining_ = false;
+        for (int port = 0; port < 5; port++) {
+            port_failed_[port] = false;
+        }
+    }
+    
+    // Zerar os contadores mantendo pacotes e reservas (checkpoint restaurado)
+    void resetStatistics() {
+        packets_forwarded_ = 0;
+        packets_discarded_ = 0;
+#ifdef NOC_ROUTER_STATS
+        counters_ = RouterCounters();
+#endif
+    }
+
+    // Gravar e restaurar o estado do router (checkpoint); as falhas não fazem
+    // parte dele, pois são reaplicadas a partir do agendamento
+    virtual void saveState(CheckpointWriter& out) const {
+        out.writeInt(packets_forwarded_);
+        out.writeInt(packets_discarded_);
+        std::vector<uint64_t> counters;
+#ifdef NOC_ROUTER_STATS
+        counters.push_back(counters_.cycles);
+        for (const PortCounters& port : counters_.ports) {
+            counters.push_back(port.occupancy_sum);
+            counters.push_back(port.blocked_cycles);
+            counters.push_back(port.arbitration_losses);
+            counters.push_back(port.link_busy_cycles);
+        }
+#endif
+        out.writeUnsigneds(counters);
+    }
+    
+    virtual void loadState(CheckpointReader& in) {
+        packets_forwarded_ = in.readInt();
+        packets_discarded_ = in.readInt();
+        // Contadores ausentes (checkpoint de build sem NOC_ROUTER_STATS) recomeçam do zero
+        std::vector<uint64_t> counters = in.readUnsigneds();
+#ifdef NOC_ROUTER_STATS
+        counters_ = RouterCounters();
+        if (counters.size() == 1 + 4 * RouterCounters::NUM_PORTS) {
+            size_t k = 0;
+            counters_.cycles = counters[k++];
+            for (PortCounters& port : counters_.ports) {
+                port.occupancy_sum = counters[k++];
+                port.blocked_cycles = counters[k++];
+                port.arbitration_losses = counters[k++];
+                port.link_busy_cycles = counters[k++];
+            }
+        }
+#endif
+    }
+
+protected:
+    int x_, y_;                          // Coordenadas do router na malha
+    int mesh_size_x_, mesh_size_y_;      // Dimensões da malha
+    std::unique_ptr<RoutingAlgorithm> routing_algorithm_;  // Algoritmo de roteamento
+    long long packets_forwarded_;        // Pacotes encaminhados desde o início
+    long long packets_discarded_;        // Pacotes descartados por falhas
+    bool failed_;                        // Router desativado
+    bool draining_;                      // Rede esvaziando para trocar o roteamento
+    bool port_failed_[5];                // Enlace de cada porta rompido
+    int link_widths_[5];                 // Largura do Channel de cada saída (0 = direto)
+    sc_signal<int>* credit_signals_[5];  // Créditos para o Channel de cada entrada (opcional)
+    PacketScoreboard* scoreboard_;       // Scoreboard da rede (opcional)
+    EventTraceWriter* trace_;            // Trace de eventos (opcional)
+    
+    // Ciclos em que o pacote ocupa o enlace da saída: ceil(tamanho / largura)
+    // flits em um Channel, um ciclo em sinais diretos
+    int linkCycles(int port, const Packet& packet) const {
+        int width = link_widths_[port];
+        return width > 0 ? (packet.getSizeBytes() + width - 1) / width : 1;
+    }
+    
+    // Registrar um evento do pacote neste router no trace
+    void trace(TraceEvent::Kind kind, const Packet& packet, int port) {
+        if (trace_) {
+            trace_->record(kind, packet.getId(), getNodeId(), port, packet.getSrcId(), packet.getDstId(),
+                           packet.isMulticast());
+        }
+    }
+    
+    // Descartar um pacote que não pode mais ser entregue (no multicast,
+    // todos os destinos que ele ainda levava)
+    void discard(const Packet& packet) {
+        packets_discarded_++;
+        if (!scoreboard_) {
+            return;
+        }
+        if (packet.isMulticast()) {
+            for (int node_id : packet.getDestinations().members()) {
+                scoreboard_->recordLoss(packet.getId(), node_id);
+            }
+        } else {
+            scoreboard_->recordLoss(packet.getId());
+        }
+    }
+    
+#ifdef NOC_ROUTER_STATS
+    RouterCounters counters_;            // Contadores de ocupação, bloqueio e utilização
+#endif
+};
+
+// Router com buffers de entrada para Network-on-Chip
+//
+// Cada porta de entrada tem um buffer por classe de mensagem, e cada porta de
+// saída um registrador por classe. Os sinais de pronto são máscaras com um bit
+// por classe, de modo que uma classe bloqueada não impede as demais de usar o
+// mesmo enlace físico.
+//
+// Pacotes multicast são replicados na árvore definida pelo roteamento: os
+// destinos da cabeça são agrupados pela porta de saída de cada um, e cada
+// saída concedida recebe uma cópia com os destinos do seu ramo. Os ramos
+// saem no mesmo ciclo ou em ciclos diferentes, conforme as saídas ficam
+// livres; a cabeça só deixa o buffer depois de copiada para todos eles.
+class Router : public BaseRouter {
+public:
+    static const int BUFFER_SIZE = 4;    // Tamanho do buffer de entrada (por classe)
+    static const int NUM_CLASSES = Packet::NUM_MESSAGE_CLASSES;
+    static const int NUM_OUTPUT_SLOTS = 5 * NUM_CLASSES;  // Saídas arbitradas (porta x classe)
+
+    // Construtor
+    Router(sc_module_name name, int x, int y, int mesh_size_x, int mesh_size_y, 
+           RoutingAlgorithm* routing_algorithm) : 
+        BaseRouter(name, x, y, mesh_size_x, mesh_size_y, routing_algorithm),
+        arbiter_(new FixedOrderArbiter(NUM_OUTPUT_SLOTS)) {
         
-        // Inicializar buffers de entrada e status de saída
-        input_buffers.resize(5);
-        output_reserved.resize(5, false);
+        // Inicializar buffers de entrada e registradores de saída (porta x classe)
+        input_buffers.resize(NUM_OUTPUT_SLOTS);
+        output_slots.resize(NUM_OUTPUT_SLOTS);
+        output_reserved.resize(NUM_OUTPUT_SLOTS, false);
+        output_presented.resize(5, -1);
+        output_next_class.resize(5, 0);
+        freed_slots.resize(NUM_OUTPUT_SLOTS, 0);
         
         // Registrar processos
         SC_METHOD(process_inputs);
         sensitive << clk.pos();
+        dont_initialize();
         
         SC_METHOD(process_routing);
         sensitive << clk.pos();
+        dont_initialize();
     }
 
     // Processo para tratar entradas dos canais
     void process_inputs() {
         // Processar cada porta de entrada
         for (int i = 0; i < 5; i++) {
-            // Se há entrada válida e estamos prontos para receber
-            if (in_valids[i].read() && input_buffers[i].size() < BUFFER_SIZE) {
+            // Transferência só ocorre se havia entrada válida e sinalizamos pronto
+            // para a classe do pacote no ciclo anterior; o remetente mantém o pacote
+            // enquanto não vê pronto, então aceitar sem ter sinalizado o duplicaria
+            if (in_valids[i].read()) {
                 // Ler pacote da entrada
                 Packet packet = in_packets[i].read();
+                int message_class = packet.getMessageClass();
                 
-                // Adicionar posição do router ao caminho
-                packet.addToPath(y_ * mesh_size_x_ + x_);
-                
-                // Incrementar contador de saltos
-                packet.incrementHops();
-                
-                // Adicionar ao buffer de entrada
-                input_buffers[i].push(packet);
+                bool accepted = in_readys[i].read() & Packet::classMask(message_class);
+                if (accepted && (failed_ || port_failed_[i])) {
+                    discard(packet);
+                    freed_slots[slot(i, message_class)]++;
+                } else if (accepted) {
+                    // Adicionar posição do router ao caminho
+                    packet.addToPath(y_ * mesh_size_x_ + x_);
+                    
+                    // Incrementar contador de saltos
+                    packet.incrementHops();
+                    
+                    // Adicionar ao buffer de entrada da classe
+                    buffer(i, message_class).push(packet);
+                }
             }
             
-            // Sinalizar se estamos prontos para receber mais pacotes
-            in_readys[i].write(input_buffers[i].size() < BUFFER_SIZE);
+            // Sinalizar para quais classes estamos prontos para receber mais pacotes;
+            // router desativado e enlace rompido aceitam e descartam tudo, para
+            // que os pacotes presos no canal do enlace não fiquem em trânsito
+            int ready_mask = 0;
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                if (buffer(i, c).size() < BUFFER_SIZE) {
+                    ready_mask |= Packet::classMask(c);
+                }
+            }
+            if (failed_ || port_failed_[i]) {
+                ready_mask = Packet::ALL_CLASSES_MASK;
+            }
+            in_readys[i].write(ready_mask);
         }
     }
 
     // Processo para tratar roteamento de pacotes
     void process_routing() {
-        // Primeiro, liberar reservas se as saídas foram aceitas
+        ROUTER_STAT(counters_.cycles++);
+        
+        // Primeiro, liberar reservas se as saídas foram aceitas na classe apresentada
         for (int i = 0; i < 5; i++) {
-            if (output_reserved[i] && out_readys[i].read()) {
-                output_reserved[i] = false; // LIBERAR A RESERVA!
+            int presented = output_presented[i];
+            if (presented >= 0 && (out_readys[i].read() & Packet::classMask(presented))) {
+                output_reserved[slot(i, presented)] = false; // LIBERAR A RESERVA!
+                output_presented[i] = -1;
             }
         }
         
-        // Resetar sinais de validade de saída
-        for (int i = 0; i < 5; i++) {
-            if (!output_reserved[i]) {
+        // Descartar o que ficou preso em router desativado ou saída com enlace rompido
+        discard_failed();
+        if (failed_) {
+            for (int i = 0; i < 5; i++) {
                 out_valids[i].write(false);
             }
+            return_credits();
+            return;
         }
         
-        // Processar pacotes nos buffers de entrada
+        // Portas de saída pedidas pela cabeça de cada buffer de entrada, um bit
+        // por porta (0 se vazio); multicast pede os ramos ainda não copiados
+        int requested[NUM_OUTPUT_SLOTS];
         for (int input_port = 0; input_port < 5; input_port++) {
-            if (!input_buffers[input_port].empty()) {
-                // Obter pacote do buffer
-                Packet packet = input_buffers[input_port].front();
+            for (int message_class = 0; message_class < NUM_CLASSES; message_class++) {
+                std::queue<Packet>& input_buffer = buffer(input_port, message_class);
+                ROUTER_STAT(counters_.ports[input_port].occupancy_sum += input_buffer.size());
+                
+                int& output_ports = requested[slot(input_port, message_class)];
+                output_ports = 0;
+                while (!input_buffer.empty()) {
+                    output_ports = requested_ports(input_buffer.front());
+                    if (output_ports != 0) {
+                        break;
+                    }
+                    
+                    // Destino inalcançável após falhas: descartar e tentar o próximo
+                    discard(input_buffer.front());
+                    input_buffer.pop();
+                    freed_slots[slot(input_port, message_class)]++;
+                }
+            }
+        }
+        
+        // Arbitrar cada saída livre entre as entradas que a pedem
+        for (int output_port = 0; output_port < 5; output_port++) {
+            for (int message_class = 0; message_class < NUM_CLASSES; message_class++) {
+                ArbiterRequest requests[5];
+                int count = 0;
+                for (int input_port = 0; input_port < 5; input_port++) {
+                    if (requested[slot(input_port, message_class)] & (1 << output_port)) {
+                        requests[count].input_port = input_port;
+                        requests[count].packet = &buffer(input_port, message_class).front();
+                        count++;
+                    }
+                }
+                if (count == 0) {
+                    continue;
+                }
                 
-                // Converter ID de destino para coordenadas x,y
-                int dest_x = packet.getDstId() % mesh_size_x_;
-                int dest_y = packet.getDstId() / mesh_size_x_;
+                int output_slot = slot(output_port, message_class);
                 
-                // Determinar porta de saída usando algoritmo de roteamento
-                Direction output_dir = routing_algorithm_->calculateOutputPort(
-                    x_, y_, dest_x, dest_y);
+                // Saída da classe ocupada ou destino sem espaço: todos ficam bloqueados
+                if (output_reserved[output_slot] ||
+                    !(output_ready(output_port) & Packet::classMask(message_class))) {
+#ifdef NOC_ROUTER_STATS
+                    for (int i = 0; i < count; i++) {
+                        counters_.ports[requests[i].input_port].blocked_cycles++;
+                    }
+#endif
+                    continue;
+                }
                 
-                int output_port = static_cast<int>(output_dir);
+                int winner = arbiter_->select(output_slot, requests, count);
+                int input_port = requests[winner].input_port;
                 
-                // Se a saída está disponível e pronta para receber
-                if (output_port != NONE && !output_reserved[output_port] && out_readys[output_port].read()) {
-                    // Encaminhar o pacote
-                    out_packets[output_port].write(packet);
-                    out_valids[output_port].write(true);
-                    output_reserved[output_port] = true;
-                    
-                    // Remover pacote do buffer de entrada
-                    input_buffers[input_port].pop();
+                // Reservar a saída da classe para o pacote vencedor (ou seu ramo)
+                Packet& head = buffer(input_port, message_class).front();
+                bool head_done = take_branch(head, output_port, output_slots[output_slot]);
+                output_reserved[output_slot] = true;
+                if (trace_) {
+                    for (int i = 0; i < count; i++) {
+                        if (i == winner) {
+                            trace(TraceEvent::HOP, output_slots[output_slot], output_port);
+                        } else {
+                            trace(TraceEvent::ARBITRATION_LOSS, *requests[i].packet, requests[i].input_port);
+                        }
+                    }
+                }
+                packets_forwarded_++;
+                ROUTER_STAT(counters_.ports[output_port].link_busy_cycles += linkCycles(output_port, output_slots[output_slot]));
+                
+#ifdef NOC_ROUTER_STATS
+                // Perda de arbitragem para as demais entradas
+                for (int i = 0; i < count; i++) {
+                    if (i != winner) {
+                        counters_.ports[requests[i].input_port].arbitration_losses++;
+                    }
+                }
+#endif
+                
+                // Remover pacote do buffer de entrada depois do último ramo
+                if (head_done) {
+                    buffer(input_port, message_class).pop();
+                    freed_slots[slot(input_port, message_class)]++;
+                } else {
+                    requested[slot(input_port, message_class)] &= ~(1 << output_port);
+                }
+            }
+        }
+        
+        // Apresentar uma classe reservada por saída: preferir as que o destino
+        // aceita, em rodízio; sem nenhuma aceita, manter a que já estava no enlace
+        for (int i = 0; i < 5; i++) {
+            int chosen = -1;
+            for (int k = 0; k < NUM_CLASSES && chosen < 0; k++) {
+                int c = (output_next_class[i] + k) % NUM_CLASSES;
+                if (output_reserved[slot(i, c)] && (output_ready(i) & Packet::classMask(c))) {
+                    chosen = c;
+                }
+            }
+            if (chosen < 0) {
+                chosen = output_presented[i];
+            }
+            for (int c = 0; c < NUM_CLASSES && chosen < 0; c++) {
+                if (output_reserved[slot(i, c)]) {
+                    chosen = c;
                 }
             }
+            
+            if (chosen < 0) {
+                out_valids[i].write(false);
+            } else if (chosen != output_presented[i]) {
+                // Encaminhar o pacote
+                out_packets[i].write(output_slots[slot(i, chosen)]);
+                out_valids[i].write(true);
+                output_presented[i] = chosen;
+                output_next_class[i] = (chosen + 1) % NUM_CLASSES;
+            }
         }
+        
+        return_credits();
     }
 
-    // Obter coordenadas do router
-    int getX() const { return x_; }
-    int getY() const { return y_; }
+    // Buffers, reservas das saídas e estado da arbitragem; o estado do árbitro
+    // só é restaurado se a política for a mesma (um fork pode trocá-la)
+    void saveState(CheckpointWriter& out) const override {
+        BaseRouter::saveState(out);
+        out.writeString(arbiter_->getName());
+        out.writeInts(arbiter_->getState());
+        for (int s = 0; s < NUM_OUTPUT_SLOTS; s++) {
+            std::queue<Packet> input_buffer = input_buffers[s];
+            out.writeUnsigned(input_buffer.size());
+            while (!input_buffer.empty()) {
+                input_buffer.front().saveState(out);
+                input_buffer.pop();
+            }
+            out.writeBool(output_reserved[s]);
+            if (output_reserved[s]) {
+                output_slots[s].saveState(out);
+            }
+        }
+        out.writeInts(output_presented);
+        out.writeInts(output_next_class);
+        out.writeInts(freed_slots);
+    }
     
-    // Obter ID do nó
-    int getNodeId() const { return y_ * mesh_size_x_ + x_; }
+    void loadState(CheckpointReader& in) override {
+        BaseRouter::loadState(in);
+        std::string arbiter_name = in.readString();
+        std::vector<int> arbiter_state = in.readInts();
+        if (arbiter_name == arbiter_->getName()) {
+            arbiter_->setState(arbiter_state);
+        }
+        for (int s = 0; s < NUM_OUTPUT_SLOTS; s++) {
+            input_buffers[s] = std::queue<Packet>();
+            size_t count = in.readSize();
+            for (size_t k = 0; k < count && in.ok(); k++) {
+                Packet packet;
+                packet.loadState(in);
+                input_buffers[s].push(packet);
+            }
+            output_reserved[s] = in.readBool();
+            if (output_reserved[s]) {
+                output_slots[s].loadState(in);
+            }
+        }
+        output_presented = in.readInts();
+        output_next_class = in.readInts();
+        freed_slots = in.readInts();
+        if (output_presented.size() != 5 || output_next_class.size() != 5 ||
+            freed_slots.size() != static_cast<size_t>(NUM_OUTPUT_SLOTS)) {
+            in.fail();
+            output_presented.assign(5, -1);
+            output_next_class.assign(5, 0);
+            freed_slots.assign(NUM_OUTPUT_SLOTS, 0);
+        }
+    }
+
+    void reset() override {
+        BaseRouter::reset();
+        input_buffers.assign(NUM_OUTPUT_SLOTS, std::queue<Packet>());
+        output_slots.assign(NUM_OUTPUT_SLOTS, Packet());
+        output_reserved.assign(NUM_OUTPUT_SLOTS, false);
+        output_presented.assign(5, -1);
+        output_next_class.assign(5, 0);
+        freed_slots.assign(NUM_OUTPUT_SLOTS, 0);
+    }
+
+    // A política deve ter sido criada com NUM_OUTPUT_SLOTS saídas
+    void setArbiter(Arbiter* arbiter) override { arbiter_.reset(arbiter); }
     
-    // Obter nome do algoritmo de roteamento
-    std::string getRoutingAlgorithmName() const {
-        return routing_algorithm_->getName();
+    std::string getArbiterName() const override {
+        return arbiter_->getName();
+    }
+
+    int getBufferOccupancy(int input_port, int message_class) const override {
+        return static_cast<int>(buffer(input_port, message_class).size());
+    }
+    
+    const Packet* getHeadPacket(int input_port, int message_class) const override {
+        const std::queue<Packet>& input_buffer = buffer(input_port, message_class);
+        return input_buffer.empty() ? nullptr : &input_buffer.front();
+    }
+    
+    // Pacotes nos buffers e nas saídas ainda não aceitas
+    void collectInFlightIds(std::vector<long long>& ids) const override {
+        for (size_t i = 0; i < input_buffers.size(); i++) {
+            std::queue<Packet> input_buffer = input_buffers[i];
+            while (!input_buffer.empty()) {
+                ids.push_back(input_buffer.front().getId());
+                input_buffer.pop();
+            }
+            if (output_reserved[i]) {
+                ids.push_back(output_slots[i].getId());
+            }
+        }
     }
 
 private:
-    int x_, y_;                          // Coordenadas do router na malha
-    int mesh_size_x_, mesh_size_y_;      // Dimensões da malha
-    std::unique_ptr<RoutingAlgorithm> routing_algorithm_;  // Algoritmo de roteamento
+    std::unique_ptr<Arbiter> arbiter_;   // Política de arbitragem das saídas
+    
+    std::vector<std::queue<Packet>> input_buffers;  // Buffers para cada porta de entrada e classe
+    std::vector<Packet> output_slots;    // Pacote reservado em cada saída e classe
+    std::vector<bool> output_reserved;   // Se a saída da classe está em uso atualmente
+    std::vector<int> output_presented;   // Classe apresentada no enlace de cada saída (-1 se nenhuma)
+    std::vector<int> output_next_class;  // Próxima classe no rodízio de cada saída
+    std::vector<int> freed_slots;        // Vagas liberadas no ciclo em cada entrada e classe
+    
+    // Máscara de classes aceitas pela saída (nenhuma se o enlace falhou)
+    int output_ready(int port) const {
+        return port_failed_[port] ? 0 : out_readys[port].read();
+    }
+    
+    // Descartar os buffers de um router desativado e as reservas presas em
+    // saídas com enlace rompido (chamado após liberar as já aceitas)
+    void discard_failed() {
+        for (int port = 0; port < 5; port++) {
+            if (!port_failed_[port]) {
+                continue;
+            }
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                if (output_reserved[slot(port, c)]) {
+                    discard(output_slots[slot(port, c)]);
+                    output_reserved[slot(port, c)] = false;
+                }
+                if (failed_) {
+                    std::queue<Packet>& input_buffer = buffer(port, c);
+                    while (!input_buffer.empty()) {
+                        discard(input_buffer.front());
+                        input_buffer.pop();
+                        freed_slots[slot(port, c)]++;
+                    }
+                }
+            }
+            if (output_presented[port] >= 0) {
+                output_presented[port] = -1;
+                out_valids[port].write(false);
+            }
+        }
+    }
+    
+    // Devolver ao Channel de cada entrada as vagas liberadas no ciclo; o sinal
+    // só é escrito quando a contagem muda
+    void return_credits() {
+        for (int port = 0; port < 5; port++) {
+            int freed = 0;
+            for (int c = 0; c < NUM_CLASSES; c++) {
+                freed |= Packet::classCount(c, freed_slots[slot(port, c)]);
+                freed_slots[slot(port, c)] = 0;
+            }
+            if (credit_signals_[port] && credit_signals_[port]->read() != freed) {
+                credit_signals_[port]->write(freed);
+            }
+        }
+    }
+    
+    // Porta de saída para o nó de destino (NONE se inalcançável, ou se a rota
+    // usa um enlace rompido enquanto a rede esvazia)
+    int route(int dst_id) const {
+        int output_port = static_cast<int>(routing_algorithm_->calculateOutputPort(
+            x_, y_, dst_id % mesh_size_x_, dst_id / mesh_size_x_));
+        return draining_ && output_port != NONE && port_failed_[output_port] ? NONE : output_port;
+    }
+    
+    // Máscara das portas de saída pedidas pelo pacote; destinos multicast
+    // inalcançáveis após falhas saem do conjunto como perdidos
+    int requested_ports(Packet& packet) {
+        if (!packet.isMulticast()) {
+            int output_port = route(packet.getDstId());
+            return output_port == NONE ? 0 : 1 << output_port;
+        }
+        int ports = 0;
+        DestinationSet reachable = packet.getDestinations();
+        for (int node_id : packet.getDestinations().members()) {
+            int output_port = route(node_id);
+            if (output_port != NONE) {
+                ports |= 1 << output_port;
+            } else {
+                reachable.remove(node_id);
+                if (scoreboard_) {
+                    scoreboard_->recordLoss(packet.getId(), node_id);
+                }
+            }
+        }
+        if (!(reachable == packet.getDestinations())) {
+            packet.setDestinations(reachable);
+        }
+        return ports;
+    }
     
-    static const int BUFFER_SIZE = 4;    // Tamanho do buffer de entrada
-    std::vector<std::queue<Packet>> input_buffers;  // Buffers para cada porta de entrada
-    std::vector<bool> output_reserved;   // Se as portas de saída estão em uso atualmente
+    // Copiar em branch o que segue da cabeça pela saída: o pacote inteiro se
+    // unicast; no multicast, uma cópia com os destinos do ramo, que deixam a
+    // cabeça. Retorna true quando não sobra nenhum destino na cabeça
+    bool take_branch(Packet& head, int output_port, Packet& branch) const {
+        branch = head;
+        if (!head.isMulticast()) {
+            return true;
+        }
+        DestinationSet taken;
+        DestinationSet rest;
+        for (int node_id : head.getDestinations().members()) {
+            if (route(node_id) == output_port) {
+                taken.add(node_id);
+            } else {
+                rest.add(node_id);
+            }
+        }
+        branch.setDestinations(taken);
+        head.setDestinations(rest);
+        return rest.empty();
+    }
+    
+    // Índice (porta, classe) nos vetores de buffers e registradores de saída
+    static int slot(int port, int message_class) { return port * NUM_CLASSES + message_class; }
+    
+    std::queue<Packet>& buffer(int port, int message_class) {
+        return input_buffers[slot(port, message_class)];
+    }
+    
+    const std::queue<Packet>& buffer(int port, int message_class) const {
+        return input_buffers[slot(port, message_class)];
+    }
 };
 
 #endif // ROUTER_H
\ No newline at end of file
@@ -0,0 +1,183 @@
+#ifndef ROUTER_STATS_H
+#define ROUTER_STATS_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Contadores de caminho crítico por router e por porta.
+// Só existem quando compilado com -DNOC_ROUTER_STATS (make ROUTER_STATS=1);
+// caso contrário ROUTER_STAT() não gera código algum.
+#ifdef NOC_ROUTER_STATS
+#define ROUTER_STAT(statement) statement
+#else
+#define ROUTER_STAT(statement)
+#endif
+
+// Contadores acumulados de uma porta (entrada e saída com o mesmo índice)
+struct PortCounters {
+    uint64_t occupancy_sum = 0;       // Soma da ocupação do buffer de entrada por ciclo
+    uint64_t blocked_cycles = 0;      // Ciclos com pacote na cabeça esperando out_readys/reserva
+    uint64_t arbitration_losses = 0;  // Ciclos em que outra entrada ganhou a mesma saída
+    uint64_t link_busy_cycles = 0;    // Ciclos de ocupação do enlace da saída (flits transmitidos)
+
+    PortCounters operator-(const PortCounters& other) const {
+        PortCounters delta;
+        delta.occupancy_sum = occupancy_sum - other.occupancy_sum;
+        delta.blocked_cycles = blocked_cycles - other.blocked_cycles;
+        delta.arbitration_losses = arbitration_losses - other.arbitration_losses;
+        delta.link_busy_cycles = link_busy_cycles - other.link_busy_cycles;
+        return delta;
+    }
+};
+
+// Contadores de um router
+struct RouterCounters {
+    static const int NUM_PORTS = 5;
+
+    uint64_t cycles = 0;
+    PortCounters ports[NUM_PORTS];
+
+    RouterCounters operator-(const RouterCounters& other) const {
+        RouterCounters delta;
+        delta.cycles = cycles - other.cycles;
+        for (int i = 0; i < NUM_PORTS; i++) {
+            delta.ports[i] = ports[i] - other.ports[i];
+        }
+        return delta;
+    }
+};
+
+// Série temporal de amostras por época (a cada N ciclos) para todos os routers
+class RouterStatsSeries {
+public:
+    RouterStatsSeries(int mesh_size_x = 0, int mesh_size_y = 0, int epoch_cycles = 0) :
+        mesh_size_x_(mesh_size_x),
+        mesh_size_y_(mesh_size_y),
+        epoch_cycles_(epoch_cycles) {}
+
+    int getEpochCycles() const { return epoch_cycles_; }
+
+    // Contadores acumulados antes da primeira época (ex.: restaurados de um checkpoint)
+    void setBaseline(const std::vector<RouterCounters>& cumulative) { last_ = cumulative; }
+
+    // Registrar uma época a partir dos contadores acumulados de cada router
+    void sample(int cycle, const std::vector<RouterCounters>& cumulative) {
+        if (last_.size() != cumulative.size()) {
+            last_.assign(cumulative.size(), RouterCounters());
+        }
+
+        Epoch epoch;
+        epoch.cycle = cycle;
+        for (size_t r = 0; r < cumulative.size(); r++) {
+            epoch.routers.push_back(cumulative[r] - last_[r]);
+        }
+        last_ = cumulative;
+        epochs_.push_back(epoch);
+    }
+
+    // CSV longo: uma linha por (época, router, porta)
+    bool writeCsv(const std::string& filename) const {
+        std::ofstream out(filename);
+        if (!out) {
+            return false;
+        }
+
+        out << "epoch,cycle,router,x,y,port,avg_occupancy,blocked_cycles,arbitration_losses,link_utilization\n";
+        for (size_t e = 0; e < epochs_.size(); e++) {
+            const Epoch& epoch = epochs_[e];
+            for (size_t r = 0; r < epoch.routers.size(); r++) {
+                const RouterCounters& counters = epoch.routers[r];
+                for (int p = 0; p < RouterCounters::NUM_PORTS; p++) {
+                    const PortCounters& port = counters.ports[p];
+                    out << e << "," << epoch.cycle << "," << r << ","
+                        << r % mesh_size_x_ << "," << r / mesh_size_x_ << ","
+                        << PORT_NAMES[p] << ","
+                        << ratio(port.occupancy_sum, counters.cycles) << ","
+                        << port.blocked_cycles << ","
+                        << port.arbitration_losses << ","
+                        << ratio(port.link_busy_cycles, counters.cycles) << "\n";
+                }
+            }
+        }
+        return true;
+    }
+
+    // JSON pronto para heatmap: por época, matrizes [y][x] de cada métrica somada nas portas
+    bool writeHeatmapJson(const std::string& filename) const {
+        std::ofstream out(filename);
+        if (!out) {
+            return false;
+        }
+
+        out << "{\n  \"mesh_x\": " << mesh_size_x_ << ",\n  \"mesh_y\": " << mesh_size_y_
+            << ",\n  \"epoch_cycles\": " << epoch_cycles_ << ",\n  \"epochs\": [\n";
+        for (size_t e = 0; e < epochs_.size(); e++) {
+            const Epoch& epoch = epochs_[e];
+            out << "    {\"cycle\": " << epoch.cycle;
+            writeMatrix(out, epoch, "avg_occupancy");
+            writeMatrix(out, epoch, "blocked_cycles");
+            writeMatrix(out, epoch, "arbitration_losses");
+            writeMatrix(out, epoch, "link_utilization");
+            out << "}" << (e + 1 < epochs_.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return true;
+    }
+
+private:
+    struct Epoch {
+        int cycle;
+        std::vector<RouterCounters> routers;
+    };
+
+    int mesh_size_x_, mesh_size_y_;
+    int epoch_cycles_;
+    std::vector<RouterCounters> last_;  // Contadores acumulados da época anterior
+    std::vector<Epoch> epochs_;
+
+    static constexpr const char* PORT_NAMES[RouterCounters::NUM_PORTS] = {
+        "NORTH", "EAST", "SOUTH", "WEST", "LOCAL"
+    };
+
+    static double ratio(uint64_t value, uint64_t cycles) {
+        return cycles > 0 ? static_cast<double>(value) / cycles : 0.0;
+    }
+
+    // Valor de uma métrica de um router somado (ocupação, bloqueios, perdas) ou
+    // tomado pelo máximo entre as portas (utilização de enlace)
+    static double routerMetric(const RouterCounters& counters, const std::string& metric) {
+        double value = 0;
+        for (int p = 0; p < RouterCounters::NUM_PORTS; p++) {
+            const PortCounters& port = counters.ports[p];
+            if (metric == "avg_occupancy") {
+                value += ratio(port.occupancy_sum, counters.cycles);
+            } else if (metric == "blocked_cycles") {
+                value += port.blocked_cycles;
+            } else if (metric == "arbitration_losses") {
+                value += port.arbitration_losses;
+            } else if (metric == "link_utilization") {
+                double utilization = ratio(port.link_busy_cycles, counters.cycles);
+                value = utilization > value ? utilization : value;
+            }
+        }
+        return value;
+    }
+
+    void writeMatrix(std::ofstream& out, const Epoch& epoch, const std::string& metric) const {
+        out << ", \"" << metric << "\": [";
+        for (int y = 0; y < mesh_size_y_; y++) {
+            out << (y > 0 ? ", " : "") << "[";
+            for (int x = 0; x < mesh_size_x_; x++) {
+                size_t r = static_cast<size_t>(y * mesh_size_x_ + x);
+                double value = r < epoch.routers.size() ? routerMetric(epoch.routers[r], metric) : 0.0;
+                out << (x > 0 ? ", " : "") << value;
+            }
+            out << "]";
+        }
+        out << "]";
+    }
+};
+
+#endif // ROUTER_STATS_H
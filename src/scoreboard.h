@@ -0,0 +1,285 @@
+#ifndef SCOREBOARD_H
+#define SCOREBOARD_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+#include "checkpoint.h"
+#include "packet.h"
+
+// Scoreboard fim-a-fim de pacotes
+//
+// Distribui IDs sequenciais na injeção e confere cada entrega: o pacote deve
+// chegar exatamente uma vez ao destino correto. As entradas ficam em uma
+// tabela indexada pelo ID, então registro e conferência são O(1); cada uma
+// sai da tabela quando o pacote é entregue ou descartado, de modo que a
+// memória acompanha apenas os pacotes pendentes, mesmo que um pacote fique
+// preso na rede. Um ID já distribuído e ausente da tabela é duplicata.
+//
+// Um pacote multicast tem um só ID e deve chegar uma vez a cada destino do
+// seu conjunto; os contadores contam entregas, então ele vale um por destino.
+class PacketScoreboard {
+public:
+    PacketScoreboard() :
+        next_id_(0),
+        injected_(0),
+        delivered_(0),
+        duplicates_(0),
+        misrouted_(0),
+        in_flight_(0),
+        dropped_(0),
+        lost_(0) {}
+
+    // Registrar um pacote injetado e devolver seu ID único
+    long long registerInjection(int dst_id) {
+        Entry entry;
+        entry.dst = dst_id;
+        entry.remaining = 1;
+        entry.lost = false;
+        pending_.emplace(next_id_, entry);
+        injected_++;
+        return next_id_++;
+    }
+
+    // Registrar um pacote multicast, esperado uma vez em cada destino
+    long long registerMulticast(const DestinationSet& destinations) {
+        Entry entry;
+        entry.dst = MULTICAST;
+        entry.remaining = destinations.count();
+        entry.lost = false;
+        long long id = next_id_++;
+        pending_.emplace(id, entry);
+        injected_ += entry.remaining;
+        multicast_[id] = MulticastTargets{destinations, destinations};
+        return id;
+    }
+
+    // Conferir a entrega de um pacote no nó node_id; retorna false se for
+    // duplicata, ID desconhecido ou destino errado
+    bool recordDelivery(long long id, int node_id) {
+        bool complete;
+        return recordDelivery(id, node_id, complete);
+    }
+
+    // Idem, indicando em complete se foi a última entrega do pacote (todos
+    // os destinos de um multicast alcançados, nenhum perdido)
+    bool recordDelivery(long long id, int node_id, bool& complete) {
+        complete = false;
+        auto found = pending_.find(id);
+        if (found == pending_.end()) {
+            // Fora da tabela só existem pacotes já entregues ou descartados
+            // (ou IDs nunca distribuídos)
+            duplicates_++;
+            return false;
+        }
+
+        Entry& entry = found->second;
+        bool correct = true;
+        if (entry.dst == MULTICAST) {
+            auto it = multicast_.find(id);
+            if (it == multicast_.end() || !it->second.pending.contains(node_id)) {
+                // Destino já alcançado (duplicata) ou fora do conjunto
+                if (it != multicast_.end() && !it->second.targets.contains(node_id)) {
+                    misrouted_++;
+                } else {
+                    duplicates_++;
+                }
+                return false;
+            }
+            it->second.pending.remove(node_id);
+        } else {
+            correct = entry.dst == node_id;
+            if (!correct) {
+                misrouted_++;
+            }
+        }
+
+        entry.remaining--;
+        delivered_++;
+        complete = entry.remaining == 0 && !entry.lost;
+        release(found);
+        return correct;
+    }
+
+    // Registrar um pacote descartado de propósito por uma falha (router
+    // desativado ou destino inalcançável); não conta como perda inesperada
+    void recordLoss(long long id) {
+        auto found = pending_.find(id);
+        if (found == pending_.end() || found->second.dst == MULTICAST) {
+            return;
+        }
+        found->second.remaining = 0;
+        lost_++;
+        release(found);
+    }
+
+    // Registrar a perda de um dos destinos de um pacote multicast
+    void recordLoss(long long id, int node_id) {
+        auto it = multicast_.find(id);
+        if (it == multicast_.end() || !it->second.pending.contains(node_id)) {
+            return;
+        }
+        auto found = pending_.find(id);
+        it->second.pending.remove(node_id);
+        found->second.remaining--;
+        found->second.lost = true;
+        lost_++;
+        release(found);
+    }
+
+    // Classificar as entregas pendentes ao final: as de pacotes que ainda
+    // estão em algum buffer/enlace (in_network_ids) estão em trânsito, as
+    // demais se perderam
+    void finalize(std::vector<long long> in_network_ids) {
+        std::sort(in_network_ids.begin(), in_network_ids.end());
+        in_flight_ = 0;
+        dropped_ = 0;
+        for (const auto& pending : pending_) {
+            if (std::binary_search(in_network_ids.begin(), in_network_ids.end(), pending.first)) {
+                in_flight_ += pending.second.remaining;
+            } else {
+                dropped_ += pending.second.remaining;
+            }
+        }
+    }
+
+    long long getInjected() const { return injected_; }
+    long long getDelivered() const { return delivered_; }
+    long long getDuplicates() const { return duplicates_; }
+    long long getMisrouted() const { return misrouted_; }
+    long long getInFlight() const { return in_flight_; }
+    long long getDropped() const { return dropped_; }
+    long long getLost() const { return lost_; }
+
+    // Recomeçar a contagem em um checkpoint restaurado: as entregas ainda
+    // pendentes passam a ser as injetadas, e a tabela é mantida
+    void resetCounts() {
+        injected_ = 0;
+        for (const auto& pending : pending_) {
+            injected_ += pending.second.remaining;
+        }
+        delivered_ = 0;
+        duplicates_ = 0;
+        misrouted_ = 0;
+        in_flight_ = 0;
+        dropped_ = 0;
+        lost_ = 0;
+    }
+
+    bool isConsistent() const {
+        return duplicates_ == 0 && misrouted_ == 0 && dropped_ == 0;
+    }
+
+    // Gravar e restaurar as entradas pendentes e os contadores (checkpoint),
+    // em ordem de ID para que o arquivo não dependa da ordem da tabela
+    void saveState(CheckpointWriter& out) const {
+        out.writeInt(next_id_);
+        out.writeInt(injected_);
+        out.writeInt(delivered_);
+        out.writeInt(duplicates_);
+        out.writeInt(misrouted_);
+        out.writeInt(lost_);
+        std::vector<long long> ids;
+        ids.reserve(pending_.size());
+        for (const auto& pending : pending_) {
+            ids.push_back(pending.first);
+        }
+        std::sort(ids.begin(), ids.end());
+        out.writeUnsigned(ids.size());
+        for (long long id : ids) {
+            const Entry& entry = pending_.at(id);
+            out.writeInt(id);
+            out.writeInt(entry.dst);
+            out.writeUnsigned(entry.remaining);
+            out.writeBool(entry.lost);
+            if (entry.dst == MULTICAST) {
+                const MulticastTargets& targets = multicast_.at(id);
+                targets.targets.saveState(out);
+                targets.pending.saveState(out);
+            }
+        }
+    }
+
+    void loadState(CheckpointReader& in) {
+        next_id_ = in.readInt();
+        injected_ = in.readInt();
+        delivered_ = in.readInt();
+        duplicates_ = in.readInt();
+        misrouted_ = in.readInt();
+        lost_ = in.readInt();
+        size_t count = in.readSize();
+        pending_.clear();
+        pending_.reserve(count);
+        multicast_.clear();
+        for (size_t i = 0; i < count && in.ok(); i++) {
+            long long id = in.readInt();
+            Entry entry;
+            entry.dst = static_cast<int>(in.readInt());
+            entry.remaining = static_cast<int>(in.readUnsigned());
+            entry.lost = in.readBool();
+            if (id < 0 || id >= next_id_ || entry.remaining <= 0) {
+                in.fail();
+                break;
+            }
+            pending_[id] = entry;
+            if (entry.dst == MULTICAST) {
+                MulticastTargets& targets = multicast_[id];
+                targets.targets.loadState(in);
+                targets.pending.loadState(in);
+            }
+        }
+    }
+
+    void printReport(std::ostream& os) const {
+        os << "Scoreboard: Injected=" << injected_
+           << ", Delivered=" << delivered_
+           << ", Duplicates=" << duplicates_
+           << ", Misrouted=" << misrouted_
+           << ", In Flight=" << in_flight_
+           << ", Dropped=" << dropped_
+           << ", Lost To Faults=" << lost_
+           << (isConsistent() ? " (OK)" : " (FAILED)") << std::endl;
+    }
+
+private:
+    static const int MULTICAST = -1;  // Entry::dst de um pacote multicast
+
+    struct Entry {
+        int dst;              // Nó de destino esperado (MULTICAST: ver multicast_)
+        int remaining;        // Entregas ainda esperadas (a entrada sai da tabela em 0)
+        bool lost;            // Algum destino descartado por falha
+    };
+
+    // Destinos de um pacote multicast: todos e os ainda não alcançados
+    struct MulticastTargets {
+        DestinationSet targets;
+        DestinationSet pending;
+    };
+
+    std::unordered_map<long long, Entry> pending_;  // Pacotes com entregas pendentes, por ID
+    long long next_id_;                             // Próximo ID a distribuir
+    std::unordered_map<long long, MulticastTargets> multicast_;  // Multicasts com entregas pendentes
+
+    long long injected_;
+    long long delivered_;
+    long long duplicates_;
+    long long misrouted_;
+    long long in_flight_;
+    long long dropped_;
+    long long lost_;
+
+    // Tirar da tabela o pacote sem entregas pendentes (e os destinos, se multicast)
+    void release(std::unordered_map<long long, Entry>::iterator found) {
+        if (found->second.remaining > 0) {
+            return;
+        }
+        if (found->second.dst == MULTICAST) {
+            multicast_.erase(found->first);
+        }
+        pending_.erase(found);
+    }
+};
+
+#endif // SCOREBOARD_H
@@ -0,0 +1,146 @@
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Configuração do tráfego gerado pelos nós
+//
+// UNIFORM: cada nó envia pacotes DATA de mão única a destinos aleatórios.
+// REQUEST_REPLY: nós comuns enviam pedidos CONTROL aos controladores de
+// memória e esperam a resposta DATA (malha fechada, limitada por
+// max_outstanding pedidos pendentes); cada controlador responde service_time
+// ciclos após receber o pedido. Pedidos e respostas usam classes de mensagem
+// distintas para não haver deadlock de protocolo.
+//
+// No modo uniforme, multicast_rate% dos pacotes gerados são multicast para
+// multicast_fanout destinos sorteados (0 = broadcast a todos os nós ativos).
+// Por padrão os routers replicam o pacote na árvore de roteamento; com
+// multicast_as_unicast a origem envia uma cópia unicast por destino, para
+// comparar com a emulação por unicasts.
+//
+// packet_sizes sorteia o tamanho em bytes de cada pacote gerado, em qualquer
+// modo, por exemplo 8 B de controle e 64 B de linha de cache; vazio, todos
+// têm Packet::SIZE_BYTES.
+struct TrafficConfig {
+    enum Mode {
+        UNIFORM,
+        REQUEST_REPLY
+    };
+
+    Mode mode;
+    std::vector<int> memory_controllers;  // Nós que atendem pedidos
+    int service_time;                     // Ciclos entre a chegada do pedido e a resposta
+    int max_outstanding;                  // Pedidos pendentes por nó antes de parar de emitir
+    std::vector<int> class_mix;           // Porcentagem dos pacotes gerados em cada classe de tráfego
+    int multicast_rate;                   // Porcentagem dos pacotes gerados que são multicast
+    int multicast_fanout;                 // Destinos de cada multicast (0 = broadcast)
+    bool multicast_as_unicast;            // Emular o multicast com uma cópia unicast por destino
+    std::vector<std::pair<int, int>> packet_sizes;  // (bytes, porcentagem) de cada tamanho de pacote
+
+    TrafficConfig() :
+        mode(UNIFORM),
+        service_time(10),
+        max_outstanding(4),
+        class_mix(1, 100),
+        multicast_rate(0),
+        multicast_fanout(0),
+        multicast_as_unicast(false) {}
+
+    bool isMemoryController(int node_id) const {
+        return mode == REQUEST_REPLY &&
+               std::find(memory_controllers.begin(), memory_controllers.end(), node_id) != memory_controllers.end();
+    }
+
+    static const char* modeName(Mode mode) {
+        return mode == REQUEST_REPLY ? "request_reply" : "uniform";
+    }
+
+    static bool parseMode(const std::string& name, Mode& mode) {
+        if (name == "uniform") {
+            mode = UNIFORM;
+        } else if (name == "request_reply") {
+            mode = REQUEST_REPLY;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // Ler uma lista de inteiros separada por vírgulas, por exemplo "0,3,12,15"
+    static bool parseIntList(const std::string& text, std::vector<int>& values) {
+        values.clear();
+        std::istringstream in(text);
+        std::string item;
+        while (std::getline(in, item, ',')) {
+            std::istringstream field(item);
+            int value;
+            if (!(field >> value)) {
+                return false;
+            }
+            values.push_back(value);
+        }
+        return !values.empty();
+    }
+
+    // Ler uma mistura de tamanhos "bytes:porcentagem,...", por exemplo
+    // "8:50,64:50"; as porcentagens somam 100
+    static bool parseSizeMix(const std::string& text, int max_bytes, std::vector<std::pair<int, int>>& sizes) {
+        sizes.clear();
+        std::istringstream in(text);
+        std::string item;
+        int total = 0;
+        while (std::getline(in, item, ',')) {
+            std::istringstream field(item);
+            int bytes, percent;
+            char separator;
+            if (!(field >> bytes >> separator >> percent) || separator != ':' ||
+                bytes < 1 || bytes > max_bytes || percent < 0) {
+                return false;
+            }
+            sizes.push_back(std::make_pair(bytes, percent));
+            total += percent;
+        }
+        return !sizes.empty() && total == 100;
+    }
+
+    // Maior e médio tamanho dos pacotes gerados, em bytes
+    int maxPacketBytes(int default_bytes) const {
+        int largest = packet_sizes.empty() ? default_bytes : 0;
+        for (const auto& size : packet_sizes) {
+            if (size.second > 0) {
+                largest = std::max(largest, size.first);
+            }
+        }
+        return largest;
+    }
+
+    double meanPacketBytes(int default_bytes) const {
+        if (packet_sizes.empty()) {
+            return default_bytes;
+        }
+        double mean = 0;
+        for (const auto& size : packet_sizes) {
+            mean += size.first * size.second / 100.0;
+        }
+        return mean;
+    }
+
+    // Controladores de memória padrão: os quatro cantos da malha
+    static std::vector<int> defaultMemoryControllers(int mesh_size_x, int mesh_size_y) {
+        std::vector<int> corners = {
+            0,
+            mesh_size_x - 1,
+            (mesh_size_y - 1) * mesh_size_x,
+            mesh_size_y * mesh_size_x - 1
+        };
+        std::sort(corners.begin(), corners.end());
+        corners.erase(std::unique(corners.begin(), corners.end()), corners.end());
+        return corners;
+    }
+};
+
+#endif // TRAFFIC_H
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "live_metrics.h"
+
+// Monitor das métricas ao vivo de uma simulação (-live NOME do simulador)
+//
+// Lê o segmento de memória compartilhada a cada -interval ms e imprime o
+// progresso, a velocidade, os pacotes em trânsito, a latência acumulada e os
+// routers com mais pacotes nos buffers. Avisa quando nenhum pacote é
+// entregue por -stall ciclos com pacotes em trânsito (possível deadlock),
+// quando os nós injetam bem menos que a carga oferecida ou os pacotes em
+// trânsito crescem a cada publicação (possível saturação) e quando as
+// publicações param. Termina quando o simulador
+// encerra; com -exit_on_alert termina no primeiro aviso com código 3, para
+// um script matar a simulação pelo PID impresso.
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " NOME [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  -interval MS      Intervalo entre leituras em milissegundos (padrão: 1000)" << std::endl;
+    std::cout << "  -once             Imprime o estado atual e termina" << std::endl;
+    std::cout << "  -wait             Espera o simulador criar o segmento NOME" << std::endl;
+    std::cout << "  -top N            Routers mais ocupados a mostrar (padrão: 5)" << std::endl;
+    std::cout << "  -stall N          Ciclos sem entregas com pacotes em trânsito até avisar (padrão: 1000)" << std::endl;
+    std::cout << "  -growth N         Publicações seguidas com mais pacotes em trânsito até avisar (padrão: 5)" << std::endl;
+    std::cout << "  -exit_on_alert    Termina com código 3 no primeiro aviso de deadlock ou saturação" << std::endl;
+    std::cout << "  -help, -h         Mostra esta mensagem de ajuda" << std::endl;
+}
+
+std::string latency_text(int latency) {
+    return latency < 0 ? ">=" + std::to_string(LiveMetricsSnapshot::LATENCY_BINS) : std::to_string(latency);
+}
+
+void print_snapshot(const LiveMetricsSnapshot& snapshot, int top) {
+    std::cout << "Run " << snapshot.run << " [" << LiveMetricsSnapshot::stateName(snapshot.state)
+              << (snapshot.closed ? ", closed" : "") << "] PID " << snapshot.pid
+              << ": Cycle=" << snapshot.cycle << "/" << snapshot.last_cycle
+              << " (" << (snapshot.last_cycle > 0 ? 100.0 * snapshot.cycle / snapshot.last_cycle : 0.0) << "%)"
+              << ", Speed=" << snapshot.cycles_per_second << " cycles/s"
+              << ", Wall=" << snapshot.wall_seconds << " s" << std::endl;
+    std::cout << "  Packets: Sent=" << snapshot.sent
+              << ", Received=" << snapshot.received
+              << ", In Flight=" << snapshot.in_flight
+              << ", Lost=" << snapshot.lost << std::endl;
+    std::cout << "  Latency: Avg=" << snapshot.latencyMean()
+              << ", P50=" << latency_text(snapshot.latencyPercentile(50))
+              << ", P99=" << latency_text(snapshot.latencyPercentile(99))
+              << ", Max=" << snapshot.latency_max << std::endl;
+
+    int num_routers = std::min(snapshot.numRouters(), LiveMetricsSnapshot::MAX_ROUTERS);
+    std::vector<std::pair<int, int>> routers;
+    long long total = 0;
+    for (int r = 0; r < num_routers; r++) {
+        total += snapshot.occupancy[r];
+        if (snapshot.occupancy[r] > 0) {
+            routers.push_back(std::make_pair(-snapshot.occupancy[r], r));
+        }
+    }
+    std::sort(routers.begin(), routers.end());
+    std::cout << "  Occupancy: Total=" << total;
+    if (!routers.empty()) {
+        std::cout << ", Top:";
+        for (int i = 0; i < top && i < static_cast<int>(routers.size()); i++) {
+            std::cout << " R" << routers[i].second << "=" << -routers[i].first;
+        }
+    }
+    std::cout << std::endl;
+}
+
+// Sinais de problema ao longo das leituras de uma execução
+class RunWatch {
+public:
+    RunWatch(int stall_cycles, int growth_samples)
+        : stall_cycles_(stall_cycles), growth_samples_(growth_samples), run_(-1), received_(0), last_delivery_(0),
+          sent_(0), sent_cycle_(0) {}
+
+    // Avisos da nova leitura (vazio = nenhum)
+    std::vector<std::string> check(const LiveMetricsSnapshot& snapshot) {
+        std::vector<std::string> alerts;
+        if (snapshot.run != run_) {
+            run_ = snapshot.run;
+            received_ = snapshot.received;
+            last_delivery_ = snapshot.cycle;
+            sent_ = snapshot.sent;
+            sent_cycle_ = snapshot.cycle;
+            in_flight_.clear();
+        }
+        if (snapshot.received != received_) {
+            received_ = snapshot.received;
+            last_delivery_ = snapshot.cycle;
+        }
+        long long sent = snapshot.sent - sent_;
+        long long cycles = snapshot.cycle - sent_cycle_;
+        sent_ = snapshot.sent;
+        sent_cycle_ = snapshot.cycle;
+        if (snapshot.state != LiveMetricsSnapshot::RUNNING) {
+            return alerts;
+        }
+
+        // Os nós só geram quando o router aceita: fontes bloqueadas injetam
+        // menos que a carga oferecida
+        double offered = snapshot.offered_load * cycles;
+        if (snapshot.cycle <= snapshot.generation_end && offered >= MIN_OFFERED_PACKETS &&
+            sent < MIN_ACCEPTED_FRACTION * offered) {
+            alerts.push_back("nós injetaram " + std::to_string(static_cast<int>(100.0 * sent / offered)) +
+                             "% da carga oferecida nos últimos " + std::to_string(cycles) +
+                             " ciclos (fontes bloqueadas, possível saturação)");
+        }
+
+        if (snapshot.in_flight > 0 && snapshot.cycle - last_delivery_ >= stall_cycles_) {
+            alerts.push_back("nenhuma entrega há " + std::to_string(snapshot.cycle - last_delivery_) + " ciclos com " +
+                             std::to_string(snapshot.in_flight) + " pacotes em trânsito (possível deadlock)");
+        }
+
+        if (in_flight_.empty() || in_flight_.back().first != snapshot.cycle) {
+            in_flight_.push_back(std::make_pair(snapshot.cycle, snapshot.in_flight));
+            if (static_cast<int>(in_flight_.size()) > growth_samples_ + 1) {
+                in_flight_.pop_front();
+            }
+        }
+        bool growing = static_cast<int>(in_flight_.size()) == growth_samples_ + 1;
+        for (size_t i = 1; growing && i < in_flight_.size(); i++) {
+            growing = in_flight_[i].second > in_flight_[i - 1].second;
+        }
+        if (growing && in_flight_.back().second > snapshot.numRouters()) {
+            alerts.push_back("pacotes em trânsito crescendo há " + std::to_string(growth_samples_) + " publicações (" +
+                             std::to_string(in_flight_.front().second) + " -> " +
+                             std::to_string(in_flight_.back().second) + "), possível saturação");
+        }
+        return alerts;
+    }
+
+private:
+    static constexpr double MIN_ACCEPTED_FRACTION = 0.9;
+    static constexpr double MIN_OFFERED_PACKETS = 100;   // Janelas menores são ruído do sorteio
+
+    int stall_cycles_;
+    int growth_samples_;
+    int run_;
+    long long received_;
+    long long last_delivery_;                            // Ciclo da última leitura com entregas novas
+    long long sent_;                                     // Enviados e ciclo da leitura anterior
+    long long sent_cycle_;
+    std::deque<std::pair<long long, long long>> in_flight_;   // (ciclo, em trânsito) das últimas leituras
+};
+
+long long now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "-help" || std::string(argv[1]) == "-h") {
+        print_usage(argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string name = argv[1];
+    int interval_ms = 1000;
+    bool once = false;
+    bool wait = false;
+    int top = 5;
+    int stall_cycles = 1000;
+    int growth_samples = 5;
+    bool exit_on_alert = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-interval" && i + 1 < argc) {
+            interval_ms = std::atoi(argv[++i]);
+        } else if (arg == "-once") {
+            once = true;
+        } else if (arg == "-wait") {
+            wait = true;
+        } else if (arg == "-top" && i + 1 < argc) {
+            top = std::atoi(argv[++i]);
+        } else if (arg == "-stall" && i + 1 < argc) {
+            stall_cycles = std::atoi(argv[++i]);
+        } else if (arg == "-growth" && i + 1 < argc) {
+            growth_samples = std::atoi(argv[++i]);
+        } else if (arg == "-exit_on_alert") {
+            exit_on_alert = true;
+        } else if (arg == "-help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cout << "Erro: Opção desconhecida: " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (interval_ms < 1 || top < 0 || stall_cycles < 1 || growth_samples < 1) {
+        std::cout << "Erro: -interval, -stall e -growth devem ser positivos e -top não negativo" << std::endl;
+        return 1;
+    }
+
+    LiveMetricsReader reader;
+    std::string error;
+    while (!reader.open(name, error)) {
+        if (!wait || !LiveMetricsMapping::isValidName(name)) {
+            std::cout << "Erro: " << error << " (simulador com -live " << name << " em execução?)" << std::endl;
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+
+    RunWatch watch(stall_cycles, growth_samples);
+    LiveMetricsSnapshot snapshot;
+    long long last_update = -1;
+    long long last_cycle = -1;
+    int last_state = -1;
+    bool warned_stale = false;
+    while (true) {
+        // Publicação nova: outro instante, ciclo, estado ou o fechamento
+        if (reader.read(snapshot) && (snapshot.updated_ms != last_update || snapshot.cycle != last_cycle ||
+                                      snapshot.state != last_state || snapshot.closed)) {
+            last_update = snapshot.updated_ms;
+            last_cycle = snapshot.cycle;
+            last_state = snapshot.state;
+            warned_stale = false;
+            print_snapshot(snapshot, top);
+            std::vector<std::string> alerts = watch.check(snapshot);
+            for (const std::string& alert : alerts) {
+                std::cout << "  Aviso: " << alert << std::endl;
+            }
+            if (!alerts.empty() && exit_on_alert) {
+                std::cout << "Monitor encerrado pelo aviso; simulador no PID " << snapshot.pid << std::endl;
+                return 3;
+            }
+            if (snapshot.closed) {
+                return snapshot.state == LiveMetricsSnapshot::ABORTED ? 2 : 0;
+            }
+        } else if (last_update >= 0 && !warned_stale && !snapshot.closed &&
+                   now_ms() - last_update > std::max(5000, 5 * interval_ms)) {
+            // Sem publicações: simulador interrompido (o segmento fica para trás) ou parado
+            std::cout << "  Aviso: sem publicações há " << (now_ms() - last_update) / 1000
+                      << " s (simulador interrompido ou parado?)" << std::endl;
+            warned_stale = true;
+        }
+        if (once) {
+            if (last_update < 0) {
+                std::cout << "Nenhuma publicação ainda em " << name << std::endl;
+            }
+            return 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+}
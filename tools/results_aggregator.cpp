@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "results_store.h"
+
+// Agregador incremental do arquivo de resultados (-results do simulador)
+//
+// Agrupa as execuções por configuração e calcula, para cada métrica, a média,
+// o intervalo de confiança de 95% (t de Student) e os percentis 5, 50 e 95
+// entre as sementes. O estado fica em um índice ao lado do arquivo (.idx),
+// com o deslocamento já lido: cada chamada lê só os registros acrescentados
+// desde a anterior. Os scripts de gráficos leem apenas o CSV agregado.
+
+namespace {
+
+const char* INDEX_MAGIC = "SimpleNoC results index";
+const int INDEX_VERSION = 1;
+
+// Uma execução de uma configuração
+struct Sample {
+    bool seeded;
+    unsigned seed;
+    std::vector<double> metrics;
+};
+
+struct ConfigResults {
+    std::vector<std::pair<std::string, std::string>> config;
+    std::vector<Sample> samples;
+};
+
+// Estado da agregação: configurações na ordem em que apareceram no arquivo
+struct Aggregation {
+    uint64_t offset = 0;  // Fim do último registro lido
+    std::vector<std::string> metric_names;
+    std::vector<ConfigResults> configs;
+    std::unordered_map<std::string, size_t> by_key;
+
+    // Acrescentar uma execução; com semente, repetir a mesma configuração e
+    // semente substitui a execução anterior (resultado idêntico ou mais novo)
+    void add(const RunResult& result) {
+        std::string key = result.key();
+        auto found = by_key.find(key);
+        if (found == by_key.end()) {
+            found = by_key.emplace(key, configs.size()).first;
+            configs.push_back(ConfigResults{result.config, {}});
+        }
+        std::vector<Sample>& samples = configs[found->second].samples;
+        if (result.seeded) {
+            for (Sample& sample : samples) {
+                if (sample.seeded && sample.seed == result.seed) {
+                    sample.metrics = result.metrics;
+                    return;
+                }
+            }
+        }
+        samples.push_back(Sample{result.seeded, result.seed, result.metrics});
+    }
+
+    size_t getRuns() const {
+        size_t runs = 0;
+        for (const ConfigResults& config : configs) {
+            runs += config.samples.size();
+        }
+        return runs;
+    }
+
+    void saveState(CheckpointWriter& out) const {
+        out.writeString(INDEX_MAGIC);
+        out.writeInt(INDEX_VERSION);
+        out.writeUnsigned(offset);
+        out.writeUnsigned(metric_names.size());
+        for (const std::string& name : metric_names) {
+            out.writeString(name);
+        }
+        out.writeUnsigned(configs.size());
+        for (const ConfigResults& config : configs) {
+            out.writeUnsigned(config.config.size());
+            for (const auto& field : config.config) {
+                out.writeString(field.first);
+                out.writeString(field.second);
+            }
+            out.writeUnsigned(config.samples.size());
+            for (const Sample& sample : config.samples) {
+                out.writeBool(sample.seeded);
+                out.writeUnsigned(sample.seed);
+                for (double value : sample.metrics) {
+                    out.writeDouble(value);
+                }
+            }
+        }
+    }
+
+    bool loadState(CheckpointReader& in) {
+        if (in.readString() != INDEX_MAGIC || in.readInt() != INDEX_VERSION) {
+            return false;
+        }
+        offset = in.readUnsigned();
+        metric_names.resize(in.readSize());
+        for (std::string& name : metric_names) {
+            name = in.readString();
+        }
+        configs.resize(in.readSize());
+        for (size_t i = 0; i < configs.size(); i++) {
+            ConfigResults& config = configs[i];
+            config.config.resize(in.readSize());
+            for (auto& field : config.config) {
+                field.first = in.readString();
+                field.second = in.readString();
+            }
+            config.samples.resize(in.readSize());
+            for (Sample& sample : config.samples) {
+                sample.seeded = in.readBool();
+                sample.seed = static_cast<unsigned>(in.readUnsigned());
+                sample.metrics.resize(metric_names.size());
+                for (double& value : sample.metrics) {
+                    value = in.readDouble();
+                }
+            }
+            if (!in.ok()) {
+                return false;
+            }
+            RunResult keyed;
+            keyed.config = config.config;
+            by_key[keyed.key()] = i;
+        }
+        return in.ok();
+    }
+};
+
+// Quantil 97,5% da t de Student (intervalo bilateral de 95%); entre os graus
+// de liberdade tabelados usa o menor, o que alarga um pouco o intervalo
+double student_t_975(size_t df) {
+    static const double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    if (df >= 1 && df <= 30) {
+        return table[df - 1];
+    }
+    if (df < 40) {
+        return 2.042;
+    }
+    if (df < 60) {
+        return 2.021;
+    }
+    return df < 120 ? 2.000 : 1.980;
+}
+
+// Percentil com interpolação linear entre as amostras ordenadas
+double percentile(const std::vector<double>& sorted, double percent) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    double position = percent / 100.0 * (sorted.size() - 1);
+    size_t below = static_cast<size_t>(std::floor(position));
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (position - below) * (sorted[above] - sorted[below]);
+}
+
+std::string csv_field(const std::string& value) {
+    if (value.find_first_of(",\"") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (char c : value) {
+        quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+// Gravar o CSV agregado: campos da configuração, número de execuções e, por
+// métrica, média, meia largura do intervalo de 95% e percentis 5/50/95
+bool write_aggregates(const Aggregation& aggregation, const std::string& filename) {
+    std::vector<std::string> fields;
+    for (const ConfigResults& config : aggregation.configs) {
+        for (const auto& field : config.config) {
+            if (std::find(fields.begin(), fields.end(), field.first) == fields.end()) {
+                fields.push_back(field.first);
+            }
+        }
+    }
+
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream out(temporary);
+        if (!out) {
+            return false;
+        }
+        for (const std::string& field : fields) {
+            out << field << ",";
+        }
+        out << "runs";
+        for (const std::string& metric : aggregation.metric_names) {
+            out << "," << metric << "_mean," << metric << "_ci95," << metric << "_p5,"
+                << metric << "_p50," << metric << "_p95";
+        }
+        out << "\n";
+
+        for (const ConfigResults& config : aggregation.configs) {
+            for (const std::string& field : fields) {
+                std::string value;
+                for (const auto& pair : config.config) {
+                    if (pair.first == field) {
+                        value = pair.second;
+                    }
+                }
+                out << csv_field(value) << ",";
+            }
+            size_t n = config.samples.size();
+            out << n;
+            for (size_t m = 0; m < aggregation.metric_names.size(); m++) {
+                std::vector<double> values;
+                double sum = 0;
+                for (const Sample& sample : config.samples) {
+                    values.push_back(sample.metrics[m]);
+                    sum += sample.metrics[m];
+                }
+                std::sort(values.begin(), values.end());
+                double mean = n > 0 ? sum / n : 0.0;
+                double squares = 0;
+                for (double value : values) {
+                    squares += (value - mean) * (value - mean);
+                }
+                double ci = n > 1 ? student_t_975(n - 1) * std::sqrt(squares / (n - 1)) / std::sqrt(n) : 0.0;
+                out << "," << mean << "," << ci << "," << percentile(values, 5) << ","
+                    << percentile(values, 50) << "," << percentile(values, 95);
+            }
+            out << "\n";
+        }
+        if (!out) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+bool save_index(const Aggregation& aggregation, const std::string& filename) {
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        CheckpointWriter out(file);
+        aggregation.saveState(out);
+        if (!file || !out.ok()) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+// "dir/resultados.nocr" -> "dir/resultados_aggregates.csv"
+std::string default_output(const std::string& results_file) {
+    size_t dot = results_file.find_last_of('.');
+    size_t slash = results_file.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = results_file.size();
+    }
+    return results_file.substr(0, dot) + "_aggregates.csv";
+}
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " RESULTADOS [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  -out ARQ          CSV agregado (padrão: RESULTADOS sem extensão + _aggregates.csv)" << std::endl;
+    std::cout << "  -index ARQ        Índice da agregação incremental (padrão: RESULTADOS.idx)" << std::endl;
+    std::cout << "  -rebuild          Ignora o índice e relê o arquivo inteiro" << std::endl;
+    std::cout << "  -help, -h         Mostra esta mensagem de ajuda" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "-help" || std::string(argv[1]) == "-h") {
+        print_usage(argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string results_file = argv[1];
+    std::string output_file = default_output(results_file);
+    std::string index_file = results_file + ".idx";
+    bool rebuild = false;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-out" && i + 1 < argc) {
+            output_file = argv[++i];
+        } else if (arg == "-index" && i + 1 < argc) {
+            index_file = argv[++i];
+        } else if (arg == "-rebuild") {
+            rebuild = true;
+        } else if (arg == "-help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cout << "Erro: Opção desconhecida: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream in(results_file, std::ios::binary);
+    if (!in) {
+        std::cout << "Erro: não foi possível abrir " << results_file << std::endl;
+        return 1;
+    }
+    ResultsReader reader(in);
+    if (!reader.readHeader()) {
+        std::cout << "Erro: " << results_file << " não é um arquivo de resultados desta versão" << std::endl;
+        return 1;
+    }
+    in.seekg(0, std::ios::end);
+    uint64_t file_size = static_cast<uint64_t>(in.tellg());
+
+    // Retomar do índice se ele corresponde a este arquivo; senão, do início
+    Aggregation aggregation;
+    bool resumed = false;
+    if (!rebuild) {
+        std::ifstream index(index_file, std::ios::binary);
+        if (index) {
+            CheckpointReader index_reader(index);
+            resumed = aggregation.loadState(index_reader) &&
+                      aggregation.metric_names == reader.getMetricNames() &&
+                      aggregation.offset >= reader.getOffset() && aggregation.offset <= file_size;
+            if (!resumed) {
+                std::cout << "Aviso: índice " << index_file << " não corresponde a " << results_file
+                          << "; agregando do início" << std::endl;
+            }
+        }
+    }
+    if (!resumed) {
+        aggregation = Aggregation();
+        aggregation.metric_names = reader.getMetricNames();
+        aggregation.offset = reader.getOffset();
+    }
+    reader.seek(aggregation.offset);
+
+    long long new_records = 0;
+    RunResult result;
+    while (reader.next(result)) {
+        aggregation.add(result);
+        new_records++;
+    }
+    if (reader.isCorrupt()) {
+        std::cout << "Aviso: registro inválido em " << results_file << " no byte " << reader.getOffset()
+                  << "; registros seguintes ignorados" << std::endl;
+    }
+    aggregation.offset = reader.getOffset();
+
+    if (!save_index(aggregation, index_file)) {
+        std::cout << "Erro: não foi possível gravar " << index_file << std::endl;
+        return 1;
+    }
+    if (!write_aggregates(aggregation, output_file)) {
+        std::cout << "Erro: não foi possível gravar " << output_file << std::endl;
+        return 1;
+    }
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Results Aggregation: New Records=" << new_records
+              << ", Total Runs=" << aggregation.getRuns()
+              << ", Configurations=" << aggregation.configs.size()
+              << ", Time=" << elapsed_ms << " ms" << std::endl;
+    std::cout << "Aggregates written to " << output_file << std::endl;
+    return 0;
+}
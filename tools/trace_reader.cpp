@@ -0,0 +1,207 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "event_trace.h"
+
+// Leitor do trace binário de eventos (-trace do simulador)
+//
+// Sem opções imprime um resumo (eventos por tipo, ciclos, pacotes e fluxos).
+// -csv grava todos os eventos em CSV, em fluxo; -timeline imprime a linha do
+// tempo de cada pacote agrupada por fluxo origem->destino (um multicast fica
+// no fluxo origem->multicast, com todos os ramos). Os filtros -window,
+// -routers e -flows têm o mesmo formato das opções do simulador.
+
+namespace {
+
+const int MULTICAST_FLOW = -1;   // Destino do fluxo dos pacotes multicast
+
+const char* portName(int port) {
+    static const char* names[5] = {"N", "E", "S", "W", "L"};
+    return port >= 0 && port < 5 ? names[port] : "?";
+}
+
+void print_usage(const char* program) {
+    std::cout << "Uso: " << program << " TRACE [opções]" << std::endl;
+    std::cout << "Opções:" << std::endl;
+    std::cout << "  -csv ARQ          Grava os eventos em CSV (- para a saída padrão)" << std::endl;
+    std::cout << "  -timeline         Linha do tempo de cada pacote, agrupada por fluxo origem->destino" << std::endl;
+    std::cout << "  -window A:B,..    Apenas eventos nas janelas de ciclos" << std::endl;
+    std::cout << "  -routers LISTA    Apenas eventos nos routers da lista" << std::endl;
+    std::cout << "  -flows S:D,..     Apenas pacotes unicast dos fluxos origem:destino" << std::endl;
+    std::cout << "  -help, -h         Mostra esta mensagem de ajuda" << std::endl;
+}
+
+// Imprimir os eventos de um pacote em uma linha: injeção, saltos (router e
+// porta de saída), perdas de arbitragem e entrega, com a latência se completo
+void print_packet_timeline(long long packet_id, const std::vector<TraceEvent>& events) {
+    std::cout << "  packet " << packet_id << ":";
+    long long injected = -1;
+    int losses = 0;
+    for (const TraceEvent& event : events) {
+        switch (event.kind) {
+        case TraceEvent::INJECT:
+            injected = event.cycle;
+            std::cout << " " << event.cycle << " inject@" << event.router;
+            break;
+        case TraceEvent::HOP:
+            std::cout << " " << event.cycle << " r" << event.router << "->" << portName(event.port);
+            break;
+        case TraceEvent::ARBITRATION_LOSS:
+            losses++;
+            break;
+        case TraceEvent::EJECT:
+            std::cout << " " << event.cycle << " eject@" << event.router;
+            if (injected >= 0) {
+                std::cout << " (latency " << event.cycle - injected << ")";
+            }
+            break;
+        }
+    }
+    if (losses > 0) {
+        std::cout << " [" << losses << " arbitration losses]";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "-help" || std::string(argv[1]) == "-h") {
+        print_usage(argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string trace_file = argv[1];
+    std::string csv_file;
+    bool timeline = false;
+    std::string windows;
+    std::string routers;
+    std::string flows;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-csv" && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (arg == "-timeline") {
+            timeline = true;
+        } else if (arg == "-window" && i + 1 < argc) {
+            windows = argv[++i];
+        } else if (arg == "-routers" && i + 1 < argc) {
+            routers = argv[++i];
+        } else if (arg == "-flows" && i + 1 < argc) {
+            flows = argv[++i];
+        } else if (arg == "-help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            std::cout << "Erro: Opção desconhecida: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::ifstream in(trace_file, std::ios::binary);
+    if (!in) {
+        std::cout << "Erro: não foi possível abrir " << trace_file << std::endl;
+        return 1;
+    }
+    EventTraceReader reader(in);
+    if (!reader.readHeader()) {
+        std::cout << "Erro: " << trace_file << " não é um trace desta versão do simulador" << std::endl;
+        return 1;
+    }
+    int num_routers = reader.getMeshSizeX() * reader.getMeshSizeY();
+
+    TraceFilter filter(num_routers);
+    if ((!windows.empty() && !filter.parseWindows(windows)) ||
+        (!routers.empty() && !filter.parseRouters(routers)) ||
+        (!flows.empty() && !filter.parseFlows(flows))) {
+        std::cout << "Erro: Filtro inválido para a malha " << reader.getMeshSizeX() << "x"
+                  << reader.getMeshSizeY() << std::endl;
+        return 1;
+    }
+
+    std::ofstream csv_stream;
+    std::ostream* csv = nullptr;
+    if (csv_file == "-") {
+        csv = &std::cout;
+    } else if (!csv_file.empty()) {
+        csv_stream.open(csv_file);
+        if (!csv_stream) {
+            std::cout << "Erro: não foi possível criar " << csv_file << std::endl;
+            return 1;
+        }
+        csv = &csv_stream;
+    }
+    if (csv) {
+        *csv << "cycle,event,packet_id,router,port,src,dst,multicast\n";
+    }
+
+    // Eventos por pacote, agrupados por fluxo, só para a linha do tempo
+    std::map<std::pair<int, int>, std::map<long long, std::vector<TraceEvent>>> packets_by_flow;
+    long long counts[TraceEvent::NUM_KINDS] = {0, 0, 0, 0};
+    long long total = 0;
+    long long first_cycle = -1;
+    long long last_cycle = -1;
+    std::map<std::pair<int, int>, long long> flow_events;
+
+    TraceEvent event;
+    while (reader.next(event)) {
+        if (event.router >= num_routers || event.src >= num_routers || event.dst >= num_routers) {
+            std::cout << "Erro: " << trace_file << ": evento fora da malha após " << total << " eventos" << std::endl;
+            return 1;
+        }
+        if (!filter.inWindow(event.cycle) || !filter.accepts(event.router, event.src, event.dst, event.multicast)) {
+            continue;
+        }
+        std::pair<int, int> flow = std::make_pair(event.src, event.multicast ? MULTICAST_FLOW : event.dst);
+
+        counts[event.kind]++;
+        total++;
+        if (first_cycle < 0) {
+            first_cycle = event.cycle;
+        }
+        last_cycle = event.cycle;
+        flow_events[flow]++;
+
+        if (csv) {
+            *csv << event.cycle << "," << TraceEvent::kindName(event.kind) << "," << event.packet_id << ","
+                 << event.router << "," << portName(event.port) << "," << event.src << "," << event.dst << ","
+                 << (event.multicast ? 1 : 0) << "\n";
+        }
+        if (timeline) {
+            packets_by_flow[flow][event.packet_id].push_back(event);
+        }
+    }
+    if (!reader.ok()) {
+        std::cout << "Aviso: " << trace_file << " truncado após " << total << " eventos" << std::endl;
+    }
+
+    if (timeline) {
+        for (const auto& flow : packets_by_flow) {
+            std::cout << "Flow " << flow.first.first << " -> ";
+            if (flow.first.second == MULTICAST_FLOW) {
+                std::cout << "multicast";
+            } else {
+                std::cout << flow.first.second;
+            }
+            std::cout << ": " << flow.second.size() << " packets" << std::endl;
+            for (const auto& packet : flow.second) {
+                print_packet_timeline(packet.first, packet.second);
+            }
+        }
+    }
+
+    // Resumo no stderr quando o CSV vai para a saída padrão
+    std::ostream& summary = csv == &std::cout ? std::cerr : std::cout;
+    summary << "Trace Summary: Mesh=" << reader.getMeshSizeX() << "x" << reader.getMeshSizeY()
+            << ", Events=" << total
+            << ", Cycles=" << (total > 0 ? first_cycle : 0) << "-" << (total > 0 ? last_cycle : 0)
+            << ", Flows=" << flow_events.size() << std::endl;
+    for (int kind = 0; kind < TraceEvent::NUM_KINDS; kind++) {
+        summary << "  " << TraceEvent::kindName(kind) << "=" << counts[kind] << std::endl;
+    }
+    return 0;
+}